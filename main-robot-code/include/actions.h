@@ -5,9 +5,6 @@
 #include <stdbool.h>
 
 /**
- * TODO: test field-centric drive
- * TODO: see if signs need to be changed
- *
  * Drives and/or rotates the robot at the specified speed. The direction is determined from the
  * hypotenuse of vx and vy (see "Parameters" for their definitions).
  *
@@ -17,6 +14,16 @@
  * This function only applies one pulse to the drive motors and should be called from within a
  * loop.
  *
+ * While heading hold is enabled, the robot translates with no rotation input and the gyro holds
+ * the heading it had when the driver last stopped rotating. Any rotation input hands control
+ * straight back to the driver.
+ *
+ * Acceleration is limited on vx, vy and r together rather than on each wheel, so the robot
+ * speeds up along a straight line; driveNumFilterCycles sets how many cycles a full-speed change
+ * takes. Only the requested command is limited: the rotation from heading hold or auto-aim is
+ * worked out afterward, so those loops act on the robot without lag. Commands are then cut while a wheel slips (see traction.h), and each wheel's command
+ * becomes the target of its velocity controller (see wheelctl.h).
+ *
  * Parameters:
  * vx - the horizontal speed of the robot; -127 for full left, 127 for full right
  * vy - the vertical speed of the robot; -127 for full down, 127 for full up
@@ -26,12 +33,61 @@
  */
 void drive(int8_t vx, int8_t vy, int8_t r, bool isFieldCentric);
 
+/**
+ * Enables or disables heading hold in drive(). Heading hold is enabled by default.
+ *
+ * Parameters:
+ * isEnabled - whether drive() should hold the robot's heading while it isn't being rotated
+ */
+void setHeadingHold(bool isEnabled);
+
+/**
+ * Enables or disables auto-aim in drive(). While it is enabled, drive() turns the robot to face
+ * the goal (see aimGetRotation()) in place of the requested rotation, which is still limited so
+ * that control returns smoothly. Auto-aim is disabled by default.
+ *
+ * Parameters:
+ * isEnabled - whether drive() should aim at the goal
+ */
+void setAim(bool isEnabled);
+
+/**
+ * Forgets the command drive() has ramped up to and the heading it is holding, so the next call
+ * ramps up from a stop and holds wherever the robot is then, rather than resuming from when the
+ * robot was last driven. opcontrolReset() calls this.
+ */
+void resetDrive(void);
+
 void takeInInternal(int8_t ispeed);
 
 void lifter(int8_t lspeed);
 
+/**
+ * Runs the shooter at the specified speed. Once the shooter has been tuned (see autotune.h), the
+ * speed is held by a velocity loop on the flywheel's IME, so the flywheel recovers from each ball
+ * instead of sagging with the battery. Until then the speed is applied directly.
+ *
+ * Nothing happens while the shooter is being tuned.
+ *
+ * Parameters:
+ * sspeed - the shooter speed; 0 to stop, 127 for full speed
+ */
 void shooter(int8_t sspeed);
 
+/**
+ * Applies a command to both shooter motors with no filtering or velocity control.
+ *
+ * Parameters:
+ * speed - the command to be applied; positive spins the flywheel forward
+ */
+void setShooterMotors(int8_t speed);
+
+/**
+ * Returns: the filtered speed shooter() last aimed for; it reaches the requested speed once the
+ * shooter has finished ramping up
+ */
+int8_t getShooterSetpoint(void);
+
 void takeInFront(int8_t speed);
 
 int8_t calculateShooterSpeed();
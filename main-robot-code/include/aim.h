@@ -0,0 +1,50 @@
+#ifndef AIM_H_
+#define AIM_H_
+
+#include "robotstate.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Sets the heading the robot faces when aimed at the goal. The bearing to the goal is taken to
+ * be the same everywhere on the field.
+ *
+ * Parameters:
+ * heading - the goal's bearing, in 1/HEADING_SCALE degrees counterclockwise from the heading
+ * 			 the gyro was calibrated at
+ */
+void aimSetGoalHeading(int32_t heading);
+
+/**
+ * Records the robot's current heading as the bearing to the goal. Pointing the robot at the goal
+ * once before the match is enough to aim from then on. If the ultrasonic sensor sees the goal,
+ * its position is recorded too, so the bearing follows the robot as odometry tracks it.
+ */
+void aimRecordGoalHeading(void);
+
+/**
+ * Finds the heading that faces the goal from where the robot is.
+ *
+ * Parameters:
+ * state - the latest robot state
+ *
+ * Returns: the bearing to the goal, in 1/HEADING_SCALE degrees
+ */
+int32_t aimGetBearing(const struct RobotState *state);
+
+/**
+ * Calculates the rotation that turns the robot to face the goal. drive() uses it in place of the
+ * driver's rotation while auto-aim is enabled (see setAim()), so the robot can still be
+ * translated freely while aiming; the heading is led to make up for that movement at the
+ * shooter's current speed.
+ *
+ * Returns: the rotational speed for drive(); positive is clockwise
+ */
+int8_t aimGetRotation(void);
+
+/**
+ * Returns: true if the robot is facing the goal and has stopped turning
+ */
+bool aimIsOnTarget(void);
+
+#endif /* AIM_H_ */
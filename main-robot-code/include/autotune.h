@@ -0,0 +1,25 @@
+#ifndef AUTOTUNE_H_
+#define AUTOTUNE_H_
+
+#include <stdbool.h>
+
+/**
+ * Starts tuning the shooter's velocity controller in a separate task. Nothing happens if tuning
+ * is already running.
+ *
+ * The flywheel is brought to a steady speed and then driven by a relay: full step above the
+ * steady command while it is too slow, and the same step below while it is too fast. The
+ * amplitude and period of the resulting oscillation give the ultimate gain and period of the
+ * flywheel, from which PI gains are calculated. The gains and the flywheel's speed at full
+ * command are stored in the configuration, which is saved once the robot is disabled.
+ *
+ * The robot must be free to spin its flywheel, and no balls should be fed while tuning.
+ */
+void autotuneStart(void);
+
+/**
+ * Returns: true while the tuning experiment has control of the shooter motors
+ */
+bool autotuneIsRunning(void);
+
+#endif /* AUTOTUNE_H_ */
@@ -0,0 +1,88 @@
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CONFIG_VERSION 4
+
+// Controller gains are stored in fixed point with 16 fractional bits
+#define CONFIG_GAIN_SHIFT 16
+#define CONFIG_GAIN_ONE (1L << CONFIG_GAIN_SHIFT)
+
+/**
+ * The tunable parameters of the robot. The record is written to flash exactly as it is laid out
+ * in memory, so fields may only be added by also incrementing CONFIG_VERSION.
+ */
+struct Config {
+	uint16_t magic;
+	uint8_t version;
+	uint8_t size;
+
+	int8_t shooterSpeedPresets[NUM_SHOOTER_SPEED_PRESETS];
+
+	int8_t driveNumFilterCycles;	// cycles drive() takes to ramp to full speed; the drive has no filter
+	int8_t intakeNumFilterCycles;
+	int8_t lifterNumFilterCycles;
+	int8_t shooterNumFilterCycles;
+
+	int8_t driveDeadband;
+	int8_t rotationDeadband;
+	int8_t rotationMaxSpeed;
+	int8_t preciseDriveExpo;
+
+	int8_t intakeSpeed;
+	int8_t lifterSpeed;
+
+	int16_t shooterMaxVelocity;	// shooter IME velocity at full command; 0 until tuned
+	int32_t shooterKp;	// shooter command per unit of velocity error
+	int32_t shooterKi;	// shooter command per unit of velocity error per control cycle
+
+	int8_t partnerRoles;	// bit mask of the ControlsRoles given to the partner joystick
+
+	int8_t currentBudget;	// A the motors may draw together before mechanisms are cut
+
+	uint16_t crc;
+} __attribute__((packed));
+
+extern struct Config config;
+
+/**
+ * Replaces the current configuration with the compiled-in defaults.
+ */
+void configLoadDefaults(void);
+
+/**
+ * Reads the configuration from the flash file system. If the stored record is missing, was
+ * written by a different version or fails its checksum, the defaults are loaded instead.
+ *
+ * Returns: true if the stored record was loaded, false if the defaults were used
+ */
+bool configLoad(void);
+
+/**
+ * Writes the current configuration to the flash file system.
+ *
+ * Writing to flash stalls most tasks, so this should only be called while the robot's actuators
+ * are stopped.
+ *
+ * Returns: true if the record was written successfully
+ */
+bool configSave(void);
+
+/**
+ * Gives the calling task exclusive write access to the configuration. Tasks that change more
+ * than a single field must hold the lock so that a save never records a half-made change.
+ * Readers don't need the lock, and configSave() takes it on its own.
+ *
+ * The lock is created by configLoad(); before then, locking does nothing.
+ */
+void configLock(void);
+
+/**
+ * Releases the lock taken with configLock().
+ */
+void configUnlock(void);
+
+#endif /* CONFIG_H_ */
@@ -0,0 +1,89 @@
+#ifndef CONTROLS_H_
+#define CONTROLS_H_
+
+#include "togglebtn.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Smallest stick deflection that counts as the driver using an axis
+#define CONTROLS_ACTIVE_THRESHOLD 20
+
+/**
+ * The groups of controls that can be handed to the partner joystick. Each button belongs to
+ * exactly one role, and the drive role also owns every analog axis.
+ */
+enum ControlsRole {
+	CONTROLS_DRIVE,	// sticks, drive profile and auto-aim
+	CONTROLS_SHOOTER,	// presets, shooter on/off and auto shoot
+	CONTROLS_LIFTER,
+	CONTROLS_INTAKE,
+	CONTROLS_ROLE_LIMIT
+};
+
+/**
+ * Reads both joysticks into a snapshot, then decides which one controls each role until the next
+ * update. Call this exactly once per control cycle; every other function here reads the
+ * snapshot, so the whole cycle sees the same inputs.
+ *
+ * A role in config.partnerRoles is controlled by the partner joystick, with two exceptions: the
+ * driver takes over any role whose controls they are using, and every role falls back to the
+ * driver while the partner joystick is disconnected.
+ */
+void controlsUpdate(void);
+
+/**
+ * Parameters:
+ * role - the role to be checked
+ *
+ * Returns: the joystick slot that controls the role this cycle
+ */
+int8_t controlsGetSlot(enum ControlsRole role);
+
+/**
+ * Parameters:
+ * role - the role the axis is read for
+ * axis - the joystick axis, from 1 to 4
+ *
+ * Returns: the axis value from the joystick controlling the role, or 0 if the axis is invalid
+ */
+int8_t controlsGetAxis(enum ControlsRole role, int8_t axis);
+
+/**
+ * Finds how a button changed since the previous cycle, like toggleBtnGet(), on the joystick
+ * controlling the role. No button needs to be registered first.
+ *
+ * Parameters:
+ * role - the role the button is read for
+ * buttonGroup - the button group, from 5 to 8
+ * button - the button in the group, one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ *
+ * Returns: the state of the button, or NO_STATE if the button is invalid
+ */
+enum ButtonState controlsGetButton(enum ControlsRole role, int8_t buttonGroup, int8_t button);
+
+/**
+ * Parameters:
+ * role - the role the button is read for
+ * buttonGroup - the button group, from 5 to 8
+ * button - the button in the group, one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ *
+ * Returns: true if the button is down on the joystick controlling the role
+ */
+bool controlsIsDown(enum ControlsRole role, int8_t buttonGroup, int8_t button);
+
+/**
+ * Copies one joystick's inputs from the snapshot, exactly as this cycle's controls see them.
+ * A disconnected joystick reads as centered with every button released.
+ *
+ * Parameters:
+ * slot - the joystick's slot, 1 or 2
+ * axes - filled in with axes 1 to 4
+ * buttons - set to button groups 5 to 8 as a mask, 4 bits per group starting with group 5 in
+ * 			 the lowest bits, with each button at the bit of its JOY_* mask
+ *
+ * Returns: true if the joystick was connected; false if the slot is invalid, in which case
+ * nothing is copied
+ */
+bool controlsGetSnapshot(int8_t slot, int8_t axes[4], uint16_t *buttons);
+
+#endif /* CONTROLS_H_ */
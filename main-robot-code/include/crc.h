@@ -0,0 +1,18 @@
+#ifndef CRC_H_
+#define CRC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Calculates the CRC-16-CCITT checksum of a block of memory.
+ *
+ * Parameters:
+ * data - the start of the block
+ * length - the size of the block in bytes
+ *
+ * Returns: the checksum of the block
+ */
+uint16_t crc16(const void *data, size_t length);
+
+#endif /* CRC_H_ */
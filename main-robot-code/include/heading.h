@@ -0,0 +1,57 @@
+#ifndef HEADING_H_
+#define HEADING_H_
+
+#include "API.h"
+#include <stdint.h>
+
+#define HEADING_SCALE 16	// heading units per degree
+
+// Gains of every controller that turns the robot to a heading
+#define HEADING_KP 3	// rotation per degree of error
+#define HEADING_KD 8	// degrees per second of turn rate per unit of rotation
+
+/**
+ * Calibrates the gyro's bias and starts the heading service. The robot must be kept still
+ * while this function runs, since it measures the gyro's drift over a short period of time.
+ *
+ * Once started, the service samples the gyro at a fixed rate, subtracts the estimated bias and
+ * keeps refining that estimate whenever the robot is stationary. Its results are published for
+ * any task to read without further processing.
+ *
+ * Parameters:
+ * gyro - the Gyro object returned by gyroInit()
+ */
+void headingInit(Gyro gyro);
+
+/**
+ * Returns: the unwrapped heading of the robot in units of 1/HEADING_SCALE of a degree; this value
+ * keeps counting past a full turn
+ */
+int32_t headingGet(void);
+
+/**
+ * Returns: the heading of the robot in degrees, between 0 and 359
+ */
+int16_t headingGetWrapped(void);
+
+/**
+ * Returns: the turn rate of the robot in degrees per second
+ */
+int16_t headingGetRate(void);
+
+/**
+ * Calculates the rotation for drive() that turns the robot toward a target heading. The gyro
+ * counts counterclockwise as positive while drive() turns clockwise on a positive rotation, so
+ * the error is taken as the heading minus the target and the turn rate damps in the same sign.
+ *
+ * Parameters:
+ * error - the heading minus the target heading, in 1/HEADING_SCALE degrees
+ * turnRate - the turn rate in degrees per second
+ *
+ * Returns: the rotation, before any limit is applied
+ */
+static inline int32_t headingGetCorrection(int32_t error, int16_t turnRate) {
+	return error * HEADING_KP / HEADING_SCALE + turnRate / HEADING_KD;
+}
+
+#endif /* HEADING_H_ */
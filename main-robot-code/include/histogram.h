@@ -0,0 +1,50 @@
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <stdint.h>
+
+#define HISTOGRAM_NUM_BUCKETS 32
+
+/**
+ * A fixed-bucket histogram of unsigned samples. Each bucket is 2^bucketShift wide, and the last
+ * bucket also collects every sample that is too large for the others.
+ */
+struct Histogram {
+	uint32_t counts[HISTOGRAM_NUM_BUCKETS];
+	uint32_t total;
+	uint32_t min, max;
+	uint8_t bucketShift;
+};
+
+/**
+ * Empties a histogram and sets the width of its buckets.
+ *
+ * Parameters:
+ * histogram - the histogram to be initialized
+ * bucketShift - the base-2 logarithm of the bucket width
+ */
+void histogramInit(struct Histogram *histogram, uint8_t bucketShift);
+
+/**
+ * Adds a sample to a histogram. This only takes a shift and a few compares, so it is cheap
+ * enough to be called from inside the control loop.
+ *
+ * Parameters:
+ * histogram - the histogram to be added to
+ * value - the sample
+ */
+void histogramAdd(struct Histogram *histogram, uint32_t value);
+
+/**
+ * Estimates a percentile of the samples in a histogram. The estimate is the upper edge of the
+ * bucket that contains the percentile, capped at the largest sample.
+ *
+ * Parameters:
+ * histogram - the histogram to be read
+ * percent - the percentile to be found, between 0 and 100
+ *
+ * Returns: the estimated percentile, or 0 if the histogram is empty
+ */
+uint32_t histogramPercentile(const struct Histogram *histogram, int8_t percent);
+
+#endif /* HISTOGRAM_H_ */
@@ -0,0 +1,80 @@
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include "profiler.h"
+#include <stdint.h>
+
+#define LATENCY_MAX_COMMANDS 4	// commands of a single closed-loop mechanism
+
+/*
+ * Input-to-motor latency is measured as part of the profiler build. Each measurement starts
+ * when a mechanism's joystick input changes and ends once its motors stop changing; an input
+ * change during a measurement starts it over, so only step responses are recorded.
+ *
+ * The velocity loops of the shooter and the drive wheels move their motors on every cycle,
+ * whether or not the input changed, so those mechanisms are measured on the commands given to
+ * their loops instead: the shooter's filtered setpoint and each wheel's target.
+ */
+#ifdef PROFILER
+
+/**
+ * Marks the start of a control cycle, ending the measurements whose motors held still through
+ * the previous cycle. Use LATENCY_TICK() instead of calling this directly.
+ */
+void latencyTick(void);
+
+/**
+ * Starts a measurement for a mechanism whose input changed. Use LATENCY_INPUT() instead of
+ * calling this directly.
+ *
+ * Parameters:
+ * mechanism - the enum Mechanism controlled by the input
+ */
+void latencyRecordInput(int8_t mechanism);
+
+/**
+ * Checks a motor command for a change. Use LATENCY_OUTPUT() instead of calling this directly.
+ *
+ * Parameters:
+ * channel - the motor's channel
+ * speed - the command applied to the motor
+ */
+void latencyRecordOutput(unsigned char channel, int16_t speed);
+
+/**
+ * Checks a closed-loop mechanism's command for a change. Use LATENCY_COMMAND() instead of
+ * calling this directly.
+ *
+ * Parameters:
+ * mechanism - the enum Mechanism the command is for
+ * index - which of the mechanism's commands, from 0 to LATENCY_MAX_COMMANDS - 1
+ * command - the command given to the mechanism's controller
+ */
+void latencyRecordCommand(int8_t mechanism, int8_t index, int16_t command);
+
+/**
+ * Empties the latency histograms.
+ */
+void latencyClear(void);
+
+/**
+ * Prints the min, max, median and 90th percentile latency of every mechanism in microseconds,
+ * both to the first change of a motor command and to the command settling.
+ */
+void latencyPrint(void);
+
+#define LATENCY_TICK() latencyTick()
+#define LATENCY_INPUT(mechanism) latencyRecordInput(mechanism)
+#define LATENCY_OUTPUT(channel, speed) latencyRecordOutput(channel, speed)
+#define LATENCY_COMMAND(mechanism, index, command) latencyRecordCommand(mechanism, index, command)
+
+#else
+
+#define LATENCY_TICK()
+#define LATENCY_INPUT(mechanism)
+#define LATENCY_OUTPUT(channel, speed)
+#define LATENCY_COMMAND(mechanism, index, command)
+
+#endif
+
+#endif /* LATENCY_H_ */
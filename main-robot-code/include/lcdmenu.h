@@ -0,0 +1,21 @@
+#ifndef LCDMENU_H_
+#define LCDMENU_H_
+
+#include "API.h"
+
+/**
+ * Initializes the LCD on the specified port and starts the tuning menu in a low-priority task.
+ *
+ * The left and right buttons move between menu items. The center button starts or stops editing
+ * a tunable item, and while editing, the left and right buttons decrease or increase its value.
+ * Changes take effect immediately and are saved to flash the next time the robot is disabled.
+ *
+ * The menu only polls the buttons and redraws at fixed rates, and it only sends a line to the LCD
+ * when its text changes, so it never competes with the control loop for time.
+ *
+ * Parameters:
+ * lcdPort - the UART port the LCD is plugged into
+ */
+void lcdmenuInit(FILE *lcdPort);
+
+#endif /* LCDMENU_H_ */
@@ -14,6 +14,16 @@
  */
 void lfilterInit(const int8_t channel, int8_t numfCycles);
 
+/**
+ * Changes the duration of the filtering effect for a channel that has already been initialized.
+ * Newly added cycles take on the most recent speed so the filtered speed doesn't jump.
+ *
+ * Parameters:
+ * channel - the motor channel to be changed
+ * num_fcycles - the new duration of the filtering effect
+ */
+void lfilterSetCycles(const int8_t channel, int8_t numfCycles);
+
 /**
  * Takes in a speed value for a specified channel and calculates a filtered speed. If the
  * channel hasn't been initialized, a speed of 0 will be returned.
@@ -54,24 +54,37 @@ extern "C" {
 #define MAX_SPEED 127
 #define MIN_SPEED (-127)
 
-#define FRONT_LEFT_MOTOR_CHANNEL 2
-#define FRONT_RIGHT_MOTOR_CHANNEL 3
-#define BACK_LEFT_MOTOR_CHANNEL 4
-#define BACK_RIGHT_MOTOR_CHANNEL 5
+// Motor channels and their mechanisms are described in mechanisms.h
+#include "mechanisms.h"
 
-#define FRONT_INTAKE_MOTOR_CHANNEL 1
-#define INTERNAL_INTAKE_MOTOR_CHANNEL 6
-#define LIFTER_MOTOR_CHANNEL 7
-
-#define SHOOTER_MOTOR_CHANNEL 8
-#define SHOOTER_MOTOR_CHANNEL2 9
+#define SHOOTER_IME_ADDRESS 0	// on the SHOOTER_MOTOR_CHANNEL2 motor
+#define FRONT_LEFT_IME_ADDRESS 1
+#define BACK_LEFT_IME_ADDRESS 2
+#define FRONT_RIGHT_IME_ADDRESS 3
+#define BACK_RIGHT_IME_ADDRESS 4
 
 #define NUM_SHOOTER_SPEED_PRESETS 3
 
+#define JOYSTICK_SLOT 1
+#define PARTNER_JOYSTICK_SLOT 2
+
+#define LIFTER_BUTTON_GROUP 5
+#define SHOOTER_ADJUST_BUTTON_GROUP 6
+#define INTAKE_BUTTON_GROUP 7
+#define CONTROL_BUTTON_GROUP 8
+
+#define DRIVE_AXIS 3
+#define STRAFE_AXIS 4
+#define ROTATION_AXIS 1
+
+#define DRIVE_PROFILE_LINEAR 0
+#define DRIVE_PROFILE_PRECISE 1
+#define NUM_DRIVE_PROFILES 2
+
 extern Gyro gyro;
 extern Ultrasonic ultra;
 
-extern int8_t shooterSpeedPresets[NUM_SHOOTER_SPEED_PRESETS];
+extern unsigned long loopTime;	// microseconds spent in the last operator control cycle
 
 // A function prototype looks exactly like its declaration, but with a semicolon instead of
 // actual code. If a function does not match a prototype, compile errors will occur.
@@ -93,6 +106,11 @@ extern int8_t shooterSpeedPresets[NUM_SHOOTER_SPEED_PRESETS];
  * so, the robot will await a switch to another mode or disable/enable cycle.
  */
 void autonomous();
+/**
+ * Prepares everything autonomous() needs ahead of time, such as the motion profiles of its
+ * moves. Called from initialize().
+ */
+void autonomousInit();
 
 /**
  * Runs pre-initialization code. This function will be started in kernel mode one time while the
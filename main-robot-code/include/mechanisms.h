@@ -0,0 +1,221 @@
+#ifndef MECHANISMS_H_
+#define MECHANISMS_H_
+
+#include <API.h>
+#include "lfilter.h"
+#include "latency.h"
+#include "power.h"
+#include "watchdog.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Every mechanism and motor on the robot is described once in the tables below; the channel
+ * constants, filter setup and output functions are all generated from them at compile time.
+ *
+ * Each mechanism is a group of motors that can be driven together as one. When a mechanism has
+ * a shared filter, its speed is filtered once on the given channel and every member gets the
+ * same filtered command; otherwise each motor keeps its own filter.
+ *
+ * Mechanisms: X(mechanism, config field holding its filter length, channel of the shared
+ * filter, 0 for a filter per motor or NO_FILTER for none, power priority). The drive is ramped
+ * by drive() and held by the wheel controllers instead, so it has no filters; its filter length
+ * sets the ramp. When the motors would draw more than the
+ * current budget, mechanisms are cut starting from the highest power priority; those with
+ * priority 0 are never cut (see power.h).
+ */
+#define NO_FILTER 0xFF
+
+#define MECHANISM_TABLE(X) \
+	X(MECHANISM_DRIVE, driveNumFilterCycles, NO_FILTER, 2) \
+	X(MECHANISM_INTAKE, intakeNumFilterCycles, 0, 3) \
+	X(MECHANISM_LIFTER, lifterNumFilterCycles, 0, 1) \
+	X(MECHANISM_SHOOTER, shooterNumFilterCycles, SHOOTER_MOTOR_CHANNEL, 0)
+
+/*
+ * Motors: X(channel name, channel, whether the motor turns backward on positive speeds,
+ * trim as a percentage of the mechanism's speed, mechanism). Trim evens out motors of the same
+ * mechanism that don't turn at quite the same speed.
+ */
+#define MOTOR_TABLE(X) \
+	X(FRONT_INTAKE_MOTOR_CHANNEL, 1, true, 100, MECHANISM_INTAKE) \
+	X(FRONT_LEFT_MOTOR_CHANNEL, 2, false, 100, MECHANISM_DRIVE) \
+	X(FRONT_RIGHT_MOTOR_CHANNEL, 3, false, 100, MECHANISM_DRIVE) \
+	X(BACK_LEFT_MOTOR_CHANNEL, 4, false, 100, MECHANISM_DRIVE) \
+	X(BACK_RIGHT_MOTOR_CHANNEL, 5, false, 100, MECHANISM_DRIVE) \
+	X(INTERNAL_INTAKE_MOTOR_CHANNEL, 6, false, 100, MECHANISM_INTAKE) \
+	X(LIFTER_MOTOR_CHANNEL, 7, false, 100, MECHANISM_LIFTER) \
+	X(SHOOTER_MOTOR_CHANNEL, 8, true, 100, MECHANISM_SHOOTER) \
+	X(SHOOTER_MOTOR_CHANNEL2, 9, false, 100, MECHANISM_SHOOTER)
+
+#define MECHANISM_ENUM(mechanism, field, filterChannel, priority) mechanism,
+#define MOTOR_ENUM(name, channel, isInverted, trim, mechanism) name = channel,
+
+enum Mechanism { MECHANISM_TABLE(MECHANISM_ENUM) NUM_MECHANISMS };
+enum { MOTOR_TABLE(MOTOR_ENUM) };
+
+// Forced so that constant arguments are always folded away, even when optimizing for size
+#define MECHANISMS_INLINE static inline __attribute__((always_inline))
+
+/**
+ * Initializes the linear filters of every mechanism with its filter length from the
+ * configuration.
+ */
+void mechanismsInit(void);
+
+/**
+ * Changes the linear filters of every mechanism to its current filter length from the
+ * configuration. Call this after editing the configuration.
+ */
+void mechanismsApplyFilterCycles(void);
+
+#define MOTOR_INVERSION_CASE(name, channel, isInverted, trim, mechanism) \
+	case channel: return isInverted;
+#define MOTOR_TRIM_CASE(name, channel, isInverted, trim, mechanism) \
+	case channel: return trim;
+#define MECHANISM_FILTER_CHANNEL_CASE(mechanism, field, filterChannel, priority) \
+	case mechanism: return filterChannel;
+#define MOTOR_MECHANISM_CASE(name, channel, isInverted, trim, mechanism) \
+	case channel: return mechanism;
+
+MECHANISMS_INLINE bool mechanismsIsInverted(unsigned char channel) {
+	switch (channel) {
+	MOTOR_TABLE(MOTOR_INVERSION_CASE)
+	}
+
+	return false;
+}
+
+MECHANISMS_INLINE int16_t mechanismsGetTrim(unsigned char channel) {
+	switch (channel) {
+	MOTOR_TABLE(MOTOR_TRIM_CASE)
+	}
+
+	return 100;
+}
+
+/**
+ * Parameters:
+ * channel - a motor's channel
+ *
+ * Returns: the mechanism the motor belongs to, or -1 if no motor is on the channel
+ */
+MECHANISMS_INLINE int8_t mechanismsGetMechanism(unsigned char channel) {
+	switch (channel) {
+	MOTOR_TABLE(MOTOR_MECHANISM_CASE)
+	}
+
+	return -1;
+}
+
+MECHANISMS_INLINE unsigned char mechanismsGetFilterChannel(enum Mechanism m) {
+	switch (m) {
+	MECHANISM_TABLE(MECHANISM_FILTER_CHANNEL_CASE)
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Applies a speed to a motor with no filtering, turning it backward if the motor is inverted
+ * and scaling it by the motor's trim and the power budget. While the watchdog has the robot in
+ * degraded mode, only the flywheel's motors are written; the watchdog ramps down the rest itself,
+ * and they are held to its speed limit while they ramp back up.
+ *
+ * The output functions are inlined, so with constant arguments the inversion, trim and
+ * mechanism checks are resolved by the compiler and only the filter and motorSet() calls remain.
+ * In the profiler build, every command is also checked for input-to-motor latency.
+ *
+ * Parameters:
+ * channel - the motor's channel
+ * speed - the speed to be applied; must be between -127 and 127
+ */
+MECHANISMS_INLINE void mechanismsSetMotorRaw(unsigned char channel, int16_t speed) {
+	int16_t trim = mechanismsGetTrim(channel), limit;
+
+	if (mechanismsGetMechanism(channel) != MECHANISM_SHOOTER) {
+		if (watchdogIsDegraded()) {
+			return;
+		}
+
+		limit = watchdogGetSpeedLimit();
+		if (speed > limit) {
+			speed = limit;
+		} else if (speed < -limit) {
+			speed = -limit;
+		}
+	}
+
+	speed = (trim == 100) ? speed : speed * trim / 100;
+	speed = powerApply(channel, speed);
+	LATENCY_OUTPUT(channel, speed);
+	motorSet(channel, mechanismsIsInverted(channel) ? -speed : speed);
+}
+
+/**
+ * Filters a speed and applies it to a single motor. This is for motors of mechanisms without a
+ * shared filter, which are driven at different speeds; see mechanismsSet() for the others.
+ *
+ * Parameters:
+ * channel - the motor's channel
+ * speed - the speed to be applied; must be between -127 and 127
+ */
+MECHANISMS_INLINE void mechanismsSetMotor(unsigned char channel, int16_t speed) {
+	mechanismsSetMotorRaw(channel, getfSpeed(channel, speed));
+}
+
+/**
+ * Runs a speed through a mechanism's shared filter without applying it, for mechanisms that
+ * adjust the filtered speed before output.
+ *
+ * Parameters:
+ * m - a mechanism with a shared filter
+ * speed - the speed to be filtered; must be between -127 and 127
+ *
+ * Returns: the filtered speed, or 0 if the mechanism has no shared filter
+ */
+MECHANISMS_INLINE int8_t mechanismsFilter(enum Mechanism m, int16_t speed) {
+	return getfSpeed(mechanismsGetFilterChannel(m), speed);
+}
+
+#define MOTOR_SET_IF_IN(name, channel, isInverted, trim, mechanism) \
+	if (m == mechanism) { \
+		mechanismsSetMotor(channel, speed); \
+	}
+
+#define MOTOR_SET_RAW_IF_IN(name, channel, isInverted, trim, mechanism) \
+	if (m == mechanism) { \
+		mechanismsSetMotorRaw(channel, speed); \
+	}
+
+/**
+ * Applies a speed to every motor of a mechanism with no filtering.
+ *
+ * Parameters:
+ * m - the mechanism to be driven
+ * speed - the speed to be applied; must be between -127 and 127
+ */
+MECHANISMS_INLINE void mechanismsSetRaw(enum Mechanism m, int16_t speed) {
+	MOTOR_TABLE(MOTOR_SET_RAW_IF_IN)
+}
+
+/**
+ * Filters a speed and applies it to every motor of a mechanism. A shared filter is only
+ * updated once, so every member always gets the same command. A mechanism with NO_FILTER gets
+ * the speed as it is.
+ *
+ * Parameters:
+ * m - the mechanism to be driven
+ * speed - the speed to be applied; must be between -127 and 127
+ */
+MECHANISMS_INLINE void mechanismsSet(enum Mechanism m, int16_t speed) {
+	if (mechanismsGetFilterChannel(m) == NO_FILTER) {
+		mechanismsSetRaw(m, speed);
+	} else if (mechanismsGetFilterChannel(m) != 0) {
+		mechanismsSetRaw(m, mechanismsFilter(m, speed));
+	} else {
+		MOTOR_TABLE(MOTOR_SET_IF_IN)
+	}
+}
+
+#endif /* MECHANISMS_H_ */
@@ -0,0 +1,43 @@
+#ifndef MEMDIAG_H_
+#define MEMDIAG_H_
+
+#include "main.h"
+#include <stdint.h>
+
+#define MEMDIAG_TASK_LIMIT 10
+
+/**
+ * Creates a task the same way as taskCreate(), but fills the unused part of its stack with a
+ * known pattern before the task starts. The deepest point the task ever reaches can later be
+ * found by looking for the first overwritten word, so stack sizes can be trimmed with
+ * confidence.
+ *
+ * Creating another task with the same name reuses its record, so short-lived tasks that are
+ * started repeatedly don't use up the table. Once MEMDIAG_TASK_LIMIT names are in use, further
+ * tasks are created normally without monitoring.
+ *
+ * Parameters:
+ * name - a name for the task in reports; must be a string constant
+ * taskCode - the function to execute in its own task
+ * stackDepth - the number of 4 byte words allocated for the task's stack
+ * parameters - an argument passed to taskCode
+ * priority - a value from TASK_PRIORITY_LOWEST to TASK_PRIORITY_HIGHEST
+ *
+ * Returns: a handle to the created task, or NULL if an error occurred
+ */
+TaskHandle memdiagTaskCreate(const char *name, TaskCode taskCode, unsigned int stackDepth,
+		void *parameters, unsigned int priority);
+
+/**
+ * Returns: the smallest number of stack words that have never been used by any monitored task,
+ * or -1 if no tasks are monitored
+ */
+int16_t memdiagGetMinFree(void);
+
+/**
+ * Prints the stack size, high-water mark and remaining free words of every monitored task to
+ * the debug terminal.
+ */
+void memdiagPrint(void);
+
+#endif /* MEMDIAG_H_ */
@@ -0,0 +1,25 @@
+#ifndef MOTIONCOMP_H_
+#define MOTIONCOMP_H_
+
+#include "robotstate.h"
+#include <stdint.h>
+
+/**
+ * Corrects a shot for the robot's own velocity. A ball leaves with the robot's velocity added to
+ * its launch velocity, so while moving toward the goal it needs less speed, and while strafing
+ * it has to be aimed upwind of the goal.
+ *
+ * All of the math is fixed-point, so this is cheap enough to run on every control cycle.
+ *
+ * Parameters:
+ * state - the latest robot state, giving the robot's heading and velocity
+ * bearing - the heading that faces the goal, in 1/HEADING_SCALE degrees
+ * speed - the shooter speed that would be used while standing still
+ * aimHeading - set to the heading the robot should face for the shot, in 1/HEADING_SCALE degrees
+ *
+ * Returns: the shooter speed to use instead
+ */
+int8_t motioncompApply(const struct RobotState *state, int32_t bearing, int8_t speed,
+		int32_t *aimHeading);
+
+#endif /* MOTIONCOMP_H_ */
@@ -0,0 +1,70 @@
+#ifndef MPROFILE_H_
+#define MPROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MPROFILE_PERIOD 20	// ms covered by each entry of a profile
+#define MPROFILE_LENGTH_LIMIT 250	// entries, so a single move can last up to 5 seconds
+
+/**
+ * A move's motor command for every control cycle, computed ahead of time so that following it
+ * is a single table lookup per cycle.
+ */
+struct MotionProfile {
+	int16_t length;
+	int8_t speeds[MPROFILE_LENGTH_LIMIT];
+};
+
+/**
+ * Computes a trapezoidal profile: constant acceleration up to the maximum velocity, cruise, then
+ * constant deceleration to a stop after exactly the given distance. Short moves that never
+ * reach the maximum velocity become triangular.
+ *
+ * Parameters:
+ * profile - the profile to be filled in
+ * distance - the length of the move; negative to move backward
+ * maxVelocity - the cruising velocity, in distance units per second
+ * maxAccel - the acceleration and deceleration, in distance units per second squared
+ * topSpeed - the velocity reached at a command of 127, used to convert velocities to commands
+ *
+ * Returns: true if the profile fits in MPROFILE_LENGTH_LIMIT entries; otherwise the profile is
+ * left empty
+ */
+bool mprofileInitTrapezoid(struct MotionProfile *profile, float distance, float maxVelocity,
+		float maxAccel, float topSpeed);
+
+/**
+ * Computes an S-curve profile, which is a trapezoidal profile whose acceleration also ramps up
+ * and down no faster than the maximum jerk. The move takes slightly longer than a trapezoidal
+ * one but doesn't jolt the robot, so wheels are less likely to slip.
+ *
+ * Parameters:
+ * profile - the profile to be filled in
+ * distance - the length of the move; negative to move backward
+ * maxVelocity - the cruising velocity, in distance units per second
+ * maxAccel - the peak acceleration, in distance units per second squared
+ * maxJerk - the rate of change of acceleration, in distance units per second cubed
+ * topSpeed - the velocity reached at a command of 127, used to convert velocities to commands
+ *
+ * Returns: true if the profile fits in MPROFILE_LENGTH_LIMIT entries; otherwise the profile is
+ * left empty
+ */
+bool mprofileInitSCurve(struct MotionProfile *profile, float distance, float maxVelocity,
+		float maxAccel, float maxJerk, float topSpeed);
+
+/**
+ * Parameters:
+ * profile - a computed profile
+ * tick - the number of control cycles since the move started
+ *
+ * Returns: the motor command for the cycle, or 0 once the move is over
+ */
+int8_t mprofileGet(const struct MotionProfile *profile, int16_t tick);
+
+/**
+ * Returns: true once the move has been followed to the end
+ */
+bool mprofileIsDone(const struct MotionProfile *profile, int16_t tick);
+
+#endif /* MPROFILE_H_ */
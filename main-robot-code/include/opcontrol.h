@@ -0,0 +1,24 @@
+#ifndef OPCONTROL_H_
+#define OPCONTROL_H_
+
+/**
+ * Precomputes the joystick response curves from the configuration, so the control loop only
+ * does table lookups. Called once by initialize().
+ */
+void opcontrolInit(void);
+
+/**
+ * Puts the shooter preset, shooter on/off, intake mode and drive ramp back to how every match
+ * starts.
+ * operatorControl() calls this whenever its task is started.
+ */
+void opcontrolReset(void);
+
+/**
+ * Runs one operator control cycle: reads the controls, commands every mechanism and records a
+ * telemetry tick. operatorControl() calls this every 20 ms; it is only public so that recorded
+ * cycles can be replayed through it on the host.
+ */
+void opcontrolStep(void);
+
+#endif /* OPCONTROL_H_ */
@@ -0,0 +1,38 @@
+#ifndef POWER_H_
+#define POWER_H_
+
+#include <stdint.h>
+
+#define POWER_PERIOD 10	// ms between updates of the budget
+
+/**
+ * Creates the lock that lets more than one task command motors. Must be called from
+ * initialize() before any task that sets motors is started.
+ */
+void powerInit(void);
+
+/**
+ * Keeps the motors' combined current within config.currentBudget so the battery doesn't sag
+ * into a brownout. Every motor command passes through here; at most every POWER_PERIOD ms, the
+ * current each motor would draw is estimated from its latest command and measured speed, and
+ * mechanisms are cut starting from the highest power priority in MECHANISM_TABLE until the rest
+ * fit. Mechanisms with priority 0 always get their full command, so the flywheel keeps its
+ * speed when everything else runs at once. The lifter is cut last, so a ball already on its way
+ * still reaches the flywheel.
+ *
+ * mechanismsSetMotorRaw() calls this; nothing else should need to.
+ *
+ * Parameters:
+ * channel - the motor's channel
+ * speed - the command the motor would get without a budget
+ *
+ * Returns: the command to apply
+ */
+int16_t powerApply(unsigned char channel, int16_t speed);
+
+/**
+ * Returns: the estimated current the latest motor commands would draw before any cuts, in mA
+ */
+int32_t powerGetDemand(void);
+
+#endif /* POWER_H_ */
@@ -0,0 +1,51 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <stdint.h>
+
+// Uncomment to time each stage of the operator control loop
+//#define PROFILER
+
+enum ProfileStage {
+	PROFILE_LOOP, PROFILE_INPUT, PROFILE_DRIVE, PROFILE_LIFTER, PROFILE_SHOOTER,
+	PROFILE_INTAKE, PROFILE_TELEMETRY, NUM_PROFILE_STAGES
+};
+
+#ifdef PROFILER
+
+extern unsigned long profilerStarts[NUM_PROFILE_STAGES];
+
+/**
+ * Marks the start and end of a stage. The elapsed time is recorded in the stage's histogram.
+ * Both macros compile to nothing when PROFILER isn't defined.
+ */
+#define PROFILE_BEGIN(stage) (profilerStarts[stage] = micros())
+#define PROFILE_END(stage) profilerRecord(stage, micros() - profilerStarts[stage])
+
+/**
+ * Clears the histograms and starts a low-priority task that waits for commands from the debug
+ * terminal. Sending 'p' prints the min, max, median and 99th percentile time of every stage in
+ * microseconds; sending 'r' clears the histograms; sending 'm' prints the stack use of every
+ * task (see memdiag.h); sending 'l' prints the input-to-motor latency of every mechanism (see
+ * latency.h).
+ */
+void profilerInit(void);
+
+/**
+ * Records the duration of one run of a stage. Use PROFILE_END() instead of calling this directly.
+ *
+ * Parameters:
+ * stage - the stage that was timed
+ * elapsed - the duration of the stage in microseconds
+ */
+void profilerRecord(enum ProfileStage stage, unsigned long elapsed);
+
+#else
+
+#define PROFILE_BEGIN(stage)
+#define PROFILE_END(stage)
+#define profilerInit()
+
+#endif
+
+#endif /* PROFILER_H_ */
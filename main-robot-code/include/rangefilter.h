@@ -0,0 +1,68 @@
+#ifndef RANGEFILTER_H_
+#define RANGEFILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * A one-dimensional Kalman filter that tracks the range to whatever is in front of the robot.
+ * Between pings, the range is predicted from how fast odometry says the robot is closing in;
+ * pings then correct it in proportion to how much each is trusted.
+ *
+ * Pings too far from the prediction to be plausible are rejected, since the ultrasonic sensor
+ * jumps whenever its beam misses the goal or hits another robot. If the pings keep disagreeing,
+ * the target really has changed and the filter starts over from the latest ping.
+ *
+ * Ranges are in 1/ODOMETRY_SCALE inches and all of the math is fixed-point.
+ */
+struct RangeFilter {
+	int32_t range;	// 1/ODOMETRY_SCALE in per 1000, so slow movement isn't rounded away
+	int32_t variance;	// (1/ODOMETRY_SCALE in)^2
+	int16_t lastPing;	// cm
+	int8_t staleCycles, rejects;
+	bool isValid;
+};
+
+/**
+ * Empties a filter; its range is unknown until the first ping.
+ *
+ * Parameters:
+ * filter - the filter to be initialized
+ */
+void rangefilterInit(struct RangeFilter *filter);
+
+/**
+ * Advances the range by the robot's own movement.
+ *
+ * Parameters:
+ * filter - the filter to be advanced
+ * velocity - the robot's forward velocity, in 1/ODOMETRY_SCALE in/s
+ * turnRate - the robot's turn rate in degrees per second; turning makes the beam sweep, so the
+ * 			  prediction is trusted less
+ * elapsed - the time since the last prediction, in ms
+ */
+void rangefilterPredict(struct RangeFilter *filter, int16_t velocity, int16_t turnRate,
+		int16_t elapsed);
+
+/**
+ * Corrects the range with an ultrasonic reading. Readings of 0 mean nothing was in range, and
+ * the same reading seen again is only used once every few calls, so neither drags the estimate
+ * toward a stale value.
+ *
+ * Parameters:
+ * filter - the filter to be corrected
+ * ping - the ultrasonic reading in cm
+ *
+ * Returns: true if the reading was used
+ */
+bool rangefilterUpdate(struct RangeFilter *filter, int16_t ping);
+
+/**
+ * Parameters:
+ * filter - the filter to be read
+ *
+ * Returns: the estimated range in 1/ODOMETRY_SCALE in, or 0 if it is unknown
+ */
+int16_t rangefilterGet(const struct RangeFilter *filter);
+
+#endif /* RANGEFILTER_H_ */
@@ -0,0 +1,75 @@
+#ifndef RCURVE_H_
+#define RCURVE_H_
+
+#include <stdint.h>
+
+#define RCURVE_PROFILE_LIMIT 3
+#define RCURVE_AXIS_LIMIT 4
+
+/**
+ * Precomputes a linear response curve with a scaled deadband for the specified profile and
+ * joystick axis. Inputs inside the deadband map to 0; outside of it, the output ramps up from 0
+ * instead of jumping straight to the deadband value.
+ *
+ * Parameters:
+ * profile - the profile to be initialized; must be between 0 and RCURVE_PROFILE_LIMIT - 1
+ * axis - the joystick axis to be initialized; must be between 1 and RCURVE_AXIS_LIMIT
+ * deadband - the input magnitude below which the output is 0
+ * maxOutput - the output magnitude at full stick deflection
+ */
+void rcurveInitDeadband(int8_t profile, int8_t axis, int8_t deadband, int8_t maxOutput);
+
+/**
+ * Precomputes an exponential response curve with a scaled deadband for the specified profile
+ * and joystick axis. The curve is a blend of a linear and a cubic response, giving finer control
+ * near the center of the stick while still reaching maxOutput at full deflection.
+ *
+ * Parameters:
+ * profile - the profile to be initialized; must be between 0 and RCURVE_PROFILE_LIMIT - 1
+ * axis - the joystick axis to be initialized; must be between 1 and RCURVE_AXIS_LIMIT
+ * deadband - the input magnitude below which the output is 0
+ * expo - the percentage of cubic response; 0 is linear, 100 is fully cubic
+ * maxOutput - the output magnitude at full stick deflection
+ */
+void rcurveInitExpo(int8_t profile, int8_t axis, int8_t deadband, int8_t expo, int8_t maxOutput);
+
+/**
+ * Precomputes a custom response curve for the specified profile and joystick axis. The curve
+ * is linearly interpolated between the given points, which are evenly spaced over input
+ * magnitudes from 0 to 127. Negative inputs mirror the positive half of the curve.
+ *
+ * Parameters:
+ * profile - the profile to be initialized; must be between 0 and RCURVE_PROFILE_LIMIT - 1
+ * axis - the joystick axis to be initialized; must be between 1 and RCURVE_AXIS_LIMIT
+ * points - the output magnitudes of the curve, starting at an input of 0
+ * numPoints - the number of points; must be at least 2
+ */
+void rcurveInitCustom(int8_t profile, int8_t axis, const int8_t *points, int8_t numPoints);
+
+/**
+ * Switches every axis to the curves of the specified profile. Axes that haven't been
+ * initialized for the profile will output 0.
+ *
+ * Parameters:
+ * profile - the profile to be used; must be between 0 and RCURVE_PROFILE_LIMIT - 1
+ */
+void rcurveSetProfile(int8_t profile);
+
+/**
+ * Returns: the profile currently in use
+ */
+int8_t rcurveGetProfile(void);
+
+/**
+ * Applies the current profile's response curve to a joystick value. This is a single table
+ * lookup, so it is safe to call on every axis on every iteration of the control loop.
+ *
+ * Parameters:
+ * axis - the joystick axis the value was read from
+ * value - the raw joystick value
+ *
+ * Returns: the shaped value, or 0 if the axis is invalid
+ */
+int8_t rcurveApply(int8_t axis, int8_t value);
+
+#endif /* RCURVE_H_ */
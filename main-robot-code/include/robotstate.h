@@ -0,0 +1,51 @@
+#ifndef ROBOTSTATE_H_
+#define ROBOTSTATE_H_
+
+#include <stdint.h>
+
+#define ODOMETRY_SCALE 16
+
+/**
+ * A consistent snapshot of everything the robot knows about itself, published together so
+ * that readers never mix values from different moments.
+ */
+struct RobotState {
+	unsigned long time;	// ms when the snapshot was taken
+	int32_t heading;	// unwrapped, in 1/HEADING_SCALE degrees counterclockwise
+	int16_t headingWrapped;	// degrees, from 0 to 359
+	int16_t turnRate;	// degrees per second counterclockwise
+	int16_t distance;	// cm measured by the ultrasonic sensor
+	int16_t shooterVelocity;	// raw IME velocity of the flywheel
+
+	// Odometry from the drive IMEs; the field frame starts at the robot's position at power on
+	// with y pointing forward, and position units are 1/ODOMETRY_SCALE inches
+	int16_t velocityX, velocityY;	// robot frame, 1/ODOMETRY_SCALE in/s, positive right and forward
+	int16_t wheelVelocities[4];	// raw IME velocity; front left, back left, front right, back right
+	int32_t x, y;	// field frame
+
+	// 1/ODOMETRY_SCALE in to whatever is in front of the robot, filtered from the ultrasonic
+	// sensor and odometry so that it holds through dropouts; 0 if unknown
+	int16_t range;
+};
+
+/**
+ * Publishes a new snapshot. Readers keep seeing the previous snapshot until this returns, and
+ * are never blocked.
+ *
+ * Only one task may publish.
+ *
+ * Parameters:
+ * state - the snapshot to be published
+ */
+void robotstatePublish(const struct RobotState *state);
+
+/**
+ * Copies the latest snapshot. If a new one is published while copying, the copy is retried, so
+ * the result is never a mix of two snapshots.
+ *
+ * Parameters:
+ * state - where the snapshot is to be copied
+ */
+void robotstateGet(struct RobotState *state);
+
+#endif /* ROBOTSTATE_H_ */
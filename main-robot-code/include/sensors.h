@@ -0,0 +1,11 @@
+#ifndef SENSORS_H_
+#define SENSORS_H_
+
+/**
+ * Starts a task that reads the gyro heading, ultrasonic sensor, flywheel IME and drive IMEs
+ * every 10 ms and publishes them as one snapshot (see robotstate.h). The sensors must already be
+ * initialized.
+ */
+void sensorsInit(void);
+
+#endif /* SENSORS_H_ */
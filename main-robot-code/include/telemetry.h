@@ -0,0 +1,41 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include "API.h"
+#include "telemetryrec.h"
+#include <stdint.h>
+
+/**
+ * Starts sending telemetry on the specified UART port. The port must already have been opened
+ * with usartInit().
+ *
+ * Records are framed into a buffer by the calling task and sent by a separate low-priority task,
+ * so sending a record never waits on the serial port.
+ *
+ * Parameters:
+ * port - uart1 or uart2
+ */
+void telemetryInit(FILE *port);
+
+/**
+ * Frames a record and queues it to be sent. If the buffer is too full to hold the whole frame,
+ * the record is dropped and counted instead.
+ *
+ * Parameters:
+ * record - the record, starting with a TelemetryHeader
+ * length - the size of the record in bytes
+ */
+void telemetrySend(const void *record, uint8_t length);
+
+/**
+ * Samples the controls snapshot, motors and sensors and queues a TelemetryTick record. Call this
+ * after the cycle's outputs are set, so the record pairs its inputs with the commands they gave.
+ */
+void telemetrySendTick(void);
+
+/**
+ * Returns: the number of records dropped because the buffer was full
+ */
+uint32_t telemetryGetDropped(void);
+
+#endif /* TELEMETRY_H_ */
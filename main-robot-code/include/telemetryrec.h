@@ -0,0 +1,61 @@
+#ifndef TELEMETRYREC_H_
+#define TELEMETRYREC_H_
+
+#include <stdint.h>
+
+/*
+ * Telemetry record layouts. This header is shared with the host-side decoder, so it must not
+ * depend on anything from the PROS API.
+ *
+ * Every record starts with a header naming its type and the schema version it was written with.
+ * Records are sent little-endian and packed, followed by a CRC-16-CCITT of the record, and the
+ * whole frame is COBS-encoded and terminated with a zero byte.
+ */
+
+#define TELEMETRY_SCHEMA_VERSION 4
+
+#define TELEMETRY_NUM_JOYSTICKS 2
+#define TELEMETRY_NUM_AXES 4
+#define TELEMETRY_NUM_MOTORS 10
+#define TELEMETRY_NUM_WHEELS 4
+
+enum TelemetryRecordType { TELEMETRY_TICK = 1 };
+
+struct TelemetryHeader {
+	uint8_t type;
+	uint8_t version;
+} __attribute__((packed));
+
+/**
+ * One joystick as the control code saw it. Each button group takes 4 bits of buttons, with group
+ * 5 in the lowest bits and each button at the bit of its JOY_DOWN, JOY_LEFT, JOY_UP or JOY_RIGHT
+ * mask. A disconnected joystick is recorded centered with every button released.
+ */
+struct TelemetryJoystick {
+	int8_t axes[TELEMETRY_NUM_AXES];	// axes 1 to 4
+	uint16_t buttons;	// button groups 5 to 8
+} __attribute__((packed));
+
+/**
+ * Sent at the end of each operator control cycle. It holds the controls snapshot the cycle acted
+ * on, with both joysticks and which of them controlled each role, the sensor readings its control
+ * loops used and the motor commands it left, so a capture can be replayed through the control
+ * code and the commands compared (see tools/replay.c). Auto-aim also depends on odometry and on
+ * the goal set from the LCD menu, which are not recorded, so aiming only replays approximately.
+ */
+struct TelemetryTick {
+	struct TelemetryHeader header;
+	uint32_t time;	// ms since the Cortex started
+	uint16_t loopTime;	// us taken by the previous cycle
+	struct TelemetryJoystick joysticks[TELEMETRY_NUM_JOYSTICKS];	// driver's, then partner's
+	uint8_t connected;	// bit 0 set if the driver's joystick is connected, bit 1 the partner's
+	uint8_t partnerRoles;	// bit n set if the partner controlled enum ControlsRole n
+	int8_t motors[TELEMETRY_NUM_MOTORS];	// motor channels 1 to 10
+	int32_t heading;	// 1/16 of a degree, unwrapped
+	int16_t distance;	// cm
+	int16_t turnRate;	// degrees per second counterclockwise
+	int16_t shooterVelocity;	// raw IME velocity of the flywheel
+	int16_t wheelVelocities[TELEMETRY_NUM_WHEELS];	// raw IME velocity; FL, BL, FR, BR
+} __attribute__((packed));
+
+#endif /* TELEMETRYREC_H_ */
@@ -0,0 +1,30 @@
+#ifndef TRACTION_H_
+#define TRACTION_H_
+
+#include "robotstate.h"
+#include <stdint.h>
+
+/**
+ * Traction control for the X-drive. With the turn rate taken from the gyro, the two wheels on
+ * each diagonal must turn at the same speed in opposite directions, so each wheel's velocity can
+ * be predicted from its partner's. A wheel turning much faster than predicted is slipping.
+ *
+ * While a wheel slips, only its own command is cut, in proportion to how far it outruns its
+ * partner, so it gets back its grip while the other three keep driving the robot at full
+ * command; heading hold takes out the small turn the uneven push causes. The cut is released
+ * gradually once the wheel grips again.
+ *
+ * Parameters:
+ * state - the latest robot state, with the wheel IME velocities and turn rate
+ * speed - the commands for the front left, back left, front right and back right wheels;
+ * 		   scaled in place
+ */
+void tractionApply(const struct RobotState *state, int16_t speed[4]);
+
+/**
+ * Returns: the percentage of its command let through to the most cut wheel; 100 unless a wheel
+ * has slipped recently
+ */
+int8_t tractionGetPercent(void);
+
+#endif /* TRACTION_H_ */
@@ -0,0 +1,42 @@
+#ifndef TRIG_H_
+#define TRIG_H_
+
+#include <stdint.h>
+
+#define TRIG_SHIFT 14
+#define TRIG_ONE (1 << TRIG_SHIFT)
+
+/**
+ * Looks up the sine of an angle in a table stored in flash, avoiding any floating-point math.
+ *
+ * Parameters:
+ * degrees - the angle in degrees; must be between 0 and 359
+ *
+ * Returns: the sine of the angle, scaled so that TRIG_ONE represents 1.0
+ */
+int16_t trigSin(int16_t degrees);
+
+/**
+ * Looks up the cosine of an angle in a table stored in flash, avoiding any floating-point math.
+ *
+ * Parameters:
+ * degrees - the angle in degrees; must be between 0 and 359
+ *
+ * Returns: the cosine of the angle, scaled so that TRIG_ONE represents 1.0
+ */
+int16_t trigCos(int16_t degrees);
+
+/**
+ * Finds the angle of a vector from the positive x axis, like atan2() but to the nearest degree
+ * above and without any floating-point math.
+ *
+ * Parameters:
+ * y - the vector's y component
+ * x - the vector's x component
+ *
+ * Returns: the angle counterclockwise from the positive x axis in degrees, from 0 to 359; 0 for
+ * a zero vector
+ */
+int16_t trigAtan2(int32_t y, int32_t x);
+
+#endif /* TRIG_H_ */
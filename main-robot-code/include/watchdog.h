@@ -0,0 +1,54 @@
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tasks watched for missed deadlines
+enum WatchdogTask {
+	WATCHDOG_CONTROL, WATCHDOG_SENSORS, NUM_WATCHDOG_TASKS
+};
+
+/**
+ * Starts a high-priority task that checks every 20 ms that each watched task has fed its
+ * heartbeat recently enough.
+ *
+ * If a task misses its deadline, the miss is counted (see watchdogGetOverruns(), shown in the LCD
+ * menu) and the robot is put into a degraded mode until every task is back on time: every motor
+ * except the flywheel ramps down to 0, while the flywheel keeps its speed so it is ready once
+ * control returns. Afterwards, the other motors are ramped back up at the same rate.
+ *
+ * A task is only watched from its first heartbeat after the robot is enabled, so tasks that
+ * stop while the robot is disabled don't trip the watchdog.
+ */
+void watchdogInit(void);
+
+/**
+ * Feeds a task's heartbeat. Each watched task should call this once per cycle.
+ *
+ * Parameters:
+ * task - the calling task
+ */
+void watchdogFeed(enum WatchdogTask task);
+
+/**
+ * Returns: true while the robot is in degraded mode
+ */
+bool watchdogIsDegraded(void);
+
+/**
+ * Returns: the largest speed the motors other than the flywheel's may be given. It falls with the
+ * ramp down in degraded mode and rises back to 127 after it ends; mechanismsSetMotorRaw()
+ * applies it.
+ */
+int16_t watchdogGetSpeedLimit(void);
+
+/**
+ * Parameters:
+ * task - a watched task
+ *
+ * Returns: the number of times the task has missed its deadline since the robot started
+ */
+uint16_t watchdogGetOverruns(enum WatchdogTask task);
+
+#endif /* WATCHDOG_H_ */
@@ -0,0 +1,45 @@
+#ifndef WHEELCTL_H_
+#define WHEELCTL_H_
+
+#include "robotstate.h"
+#include <stdint.h>
+
+#define WHEELCTL_PERIOD 10	// ms, the same as the sensor task that measures the wheels
+
+/**
+ * Starts a task that holds each drive wheel at its target velocity every WHEELCTL_PERIOD ms.
+ * Each wheel's command is a feedforward from a simple motor model, which alone drives the
+ * wheel as the open-loop drive used to, plus a PI correction from its IME velocity. Motors
+ * that are weaker than the rest get more command, so the robot no longer pulls to one side.
+ *
+ * The correction is limited, so a disconnected IME costs at most that much command. Nothing is
+ * output while the robot is disabled or the watchdog has the robot in degraded mode.
+ */
+void wheelctlInit(void);
+
+/**
+ * Sets the wheel velocity targets. Targets are given as the commands the open-loop drive
+ * would have used; full command is the free speed of the drive motors.
+ *
+ * Parameters:
+ * commands - targets for the front left, back left, front right and back right wheels, each
+ * 			  between -127 and 127
+ */
+void wheelctlSetTargets(const int16_t commands[4]);
+
+/**
+ * Runs one cycle of every wheel's controller. The task calls this on its own; it is only
+ * public so that the simulator can step the controllers in time with its model.
+ *
+ * Parameters:
+ * state - the latest robot state, with the wheel IME velocities
+ */
+void wheelctlUpdate(const struct RobotState *state);
+
+/**
+ * Clears the controllers' targets and integrals, so they hold the wheels stopped until drive()
+ * sets new targets, and then start from the feedforward alone.
+ */
+void wheelctlReset(void);
+
+#endif /* WHEELCTL_H_ */
@@ -2,25 +2,119 @@
 
 #include "main.h"
 #include "API.h"
-#include "lfilter.h"
+#include "heading.h"
+#include "trig.h"
+#include "config.h"
+#include "autotune.h"
+#include "robotstate.h"
+#include "aim.h"
+#include "motioncomp.h"
+#include "traction.h"
+#include "wheelctl.h"
 #include <math.h>
 
+#define HEADING_HOLD_MAX_ROTATION 40
+#define HEADING_HOLD_SETTLE_CYCLES 15	// cycles the robot is left to coast after a turn
+
+/*
+ * Per-axis acceleration limits, as percentages of the base rate set by the drive filter length.
+ * At 100, an axis ramps from 0 to full speed in driveNumFilterCycles cycles, like the filter.
+ */
+#define ACCEL_STRAFE_PERCENT 100
+#define ACCEL_DRIVE_PERCENT 100
+#define ACCEL_ROTATION_PERCENT 100
+#define ACCEL_SHIFT 8	// commands are ramped in 1/256 steps
+
+static bool isHeadingHoldOn = true;
+static bool isAimOn = false;
+static int32_t targetHeading = 0;
+static int8_t settleCycles = HEADING_HOLD_SETTLE_CYCLES;	// so the first hold starts from where the robot is
+static int8_t shooterSetpoint = 0;
+static int32_t commands[3] = { 0 };	// the limited vx, vy and r, scaled by 2^ACCEL_SHIFT
+
+static int8_t holdHeading(const struct RobotState *state, int8_t vx, int8_t vy, int8_t r) {
+	int32_t correction;
+
+	if (r != 0 || (vx == 0 && vy == 0) || !isHeadingHoldOn) {
+		settleCycles = HEADING_HOLD_SETTLE_CYCLES;
+	} else if (settleCycles > 0) {
+		--settleCycles;
+	} else {
+		correction = headingGetCorrection(state->heading - targetHeading, state->turnRate);
+
+		if (correction > HEADING_HOLD_MAX_ROTATION) {
+			correction = HEADING_HOLD_MAX_ROTATION;
+		} else if (correction < -HEADING_HOLD_MAX_ROTATION) {
+			correction = -HEADING_HOLD_MAX_ROTATION;
+		}
+
+		return (int8_t) correction;
+	}
+
+	// Keep following the robot until it settles so the hold doesn't snap it back
+	targetHeading = state->heading;
+	return r;
+}
+
+/*
+ * Moves the command vector toward the requested one, no faster than any axis allows. The whole
+ * change is scaled by the tightest axis, so the direction of the change is kept and the robot
+ * accelerates in a straight line instead of bending as each wheel ramps on its own.
+ */
+static void limitAcceleration(int8_t *vx, int8_t *vy, int8_t *r) {
+	static const int16_t percents[3] = { ACCEL_STRAFE_PERCENT, ACCEL_DRIVE_PERCENT,
+			ACCEL_ROTATION_PERCENT };
+	int8_t *targets[3] = { vx, vy, r };
+	int32_t changes[3], base, limit, scale = 1 << ACCEL_SHIFT;
+	int8_t i;
+
+	base = (MAX_SPEED << ACCEL_SHIFT) / (config.driveNumFilterCycles > 0
+			? config.driveNumFilterCycles : 1);
+
+	for (i = 0; i < 3; ++i) {
+		changes[i] = (int32_t) *targets[i] * (1 << ACCEL_SHIFT) - commands[i];
+		limit = base * percents[i] / 100;
+
+		if (abs(changes[i]) > limit && (limit << ACCEL_SHIFT) / abs(changes[i]) < scale) {
+			scale = (limit << ACCEL_SHIFT) / abs(changes[i]);
+		}
+	}
+
+	for (i = 0; i < 3; ++i) {
+		commands[i] += (changes[i] * scale) >> ACCEL_SHIFT;
+		*targets[i] = (int8_t) (commands[i] >> ACCEL_SHIFT);
+	}
+}
+
 void drive(int8_t vx, int8_t vy, int8_t r, bool isFieldCentric) {
 	int16_t speed[4];	// one for each wheel
 	int16_t absRawSpeed, maxRawSpeed;
+	int16_t x, y;
 	int8_t i;
+	struct RobotState state;
+
+	robotstateGet(&state);
+	limitAcceleration(&vx, &vy, &r);
+
+	// The heading controllers come after the limit, which would otherwise lag their corrections
+	if (isAimOn) {
+		r = aimGetRotation();
+	}
+	r = holdHeading(&state, vx, vy, r);
+	x = vx;
+	y = vy;
 
+	// Rotate the field-relative command into the robot's frame, back by the robot's heading
 	if (isFieldCentric) {
-		float heading = -gyroGet(gyro) % 360 * M_PI / 180;
-		float v = hypotf(vx, vy);
-		vx = (int8_t) (v * sinf(heading));
-		vy = (int8_t) (v * cosf(heading));
+		int16_t s = trigSin(state.headingWrapped), c = trigCos(state.headingWrapped);
+		x = ((int32_t) vx * c + (int32_t) vy * s) >> TRIG_SHIFT;
+		y = ((int32_t) vy * c - (int32_t) vx * s) >> TRIG_SHIFT;
 	}
 
-	speed[0] = vy + vx + r;	// front left
-	speed[1] = vy - vx + r;	// back left
-	speed[2] = -vy + vx + r;	// front right
-	speed[3] = -vy - vx + r;	// back right
+	speed[0] = y + x + r;	// front left
+	speed[1] = y - x + r;	// back left
+	speed[2] = -y + x + r;	// front right
+	speed[3] = -y - x + r;	// back right
 
 	maxRawSpeed = 0;
 	for (i = 0; i < 4; ++i) {
@@ -30,53 +124,115 @@ void drive(int8_t vx, int8_t vy, int8_t r, bool isFieldCentric) {
 		}
 	}
 
-	if (maxRawSpeed > MAX_SPEED) {	// TODO: replace MAXIMUM_SHOOTER_CAP with macro
+	// Every wheel is scaled by the same factor so the robot still moves in the requested direction
+	if (maxRawSpeed > MAX_SPEED) {
 		float scale = (float) maxRawSpeed / MAX_SPEED;
 		for (i = 0; i < 4; ++i) {
 			speed[i] /= scale;
 		}
 	}
 
-	// Linear filtering for gradual acceleration and reduced motor wear
-	speed[0] = getfSpeed(FRONT_LEFT_MOTOR_CHANNEL, speed[0]);
-	speed[1] = getfSpeed(BACK_LEFT_MOTOR_CHANNEL, speed[1]);
-	speed[2] = getfSpeed(FRONT_RIGHT_MOTOR_CHANNEL, speed[2]);
-	speed[3] = getfSpeed(BACK_RIGHT_MOTOR_CHANNEL, speed[3]);
+	tractionApply(&state, speed);
+
+	// Already ramped by limitAcceleration(); the wheel controllers take it from here
+	wheelctlSetTargets(speed);
+}
+
+void resetDrive(void) {
+	int8_t i;
+
+	for (i = 0; i < 3; ++i) {
+		commands[i] = 0;
+	}
+	settleCycles = HEADING_HOLD_SETTLE_CYCLES;
+}
+
+void setHeadingHold(bool isEnabled) {
+	isHeadingHoldOn = isEnabled;
+}
 
-	motorSet(FRONT_LEFT_MOTOR_CHANNEL, speed[0]);
-	motorSet(BACK_LEFT_MOTOR_CHANNEL, speed[1]);
-	motorSet(FRONT_RIGHT_MOTOR_CHANNEL, speed[2]);
-	motorSet(BACK_RIGHT_MOTOR_CHANNEL, speed[3]);
+void setAim(bool isEnabled) {
+	isAimOn = isEnabled;
 }
 
 void takeInInternal(int8_t ispeed) {
-	// Linear filtering for gradual acceleration and reduced motor wear
-	int8_t ispeed2 = getfSpeed(INTERNAL_INTAKE_MOTOR_CHANNEL, ispeed);
-	motorSet(INTERNAL_INTAKE_MOTOR_CHANNEL, ispeed2);
+	// The internal intake has a filter of its own, apart from the front intake's
+	mechanismsSetMotor(INTERNAL_INTAKE_MOTOR_CHANNEL, ispeed);
 }
 
 void lifter(int8_t lspeed) {
-	// Linear filtering for gradual acceleration and reduced motor wear
-	int8_t lspeed2 = getfSpeed(LIFTER_MOTOR_CHANNEL, lspeed);
-	motorSet(LIFTER_MOTOR_CHANNEL, lspeed2);
+	mechanismsSet(MECHANISM_LIFTER, lspeed);
+}
+
+// Filtered speed plus PI correction from the velocity error; returns the command to apply
+static int16_t controlShooter(int8_t setpoint) {
+	static int32_t integral = 0;
+	int32_t target, error, output;
+	struct RobotState state;
+
+	if (setpoint == 0) {
+		integral = 0;
+		return 0;
+	}
+
+	robotstateGet(&state);
+	target = (int32_t) setpoint * config.shooterMaxVelocity / MAX_SPEED;
+	error = target - state.shooterVelocity;
+
+	integral += error * config.shooterKi;
+	if (integral > ((int32_t) MAX_SPEED << CONFIG_GAIN_SHIFT)) {
+		integral = (int32_t) MAX_SPEED << CONFIG_GAIN_SHIFT;
+	} else if (integral < -((int32_t) MAX_SPEED << CONFIG_GAIN_SHIFT)) {
+		integral = -((int32_t) MAX_SPEED << CONFIG_GAIN_SHIFT);
+	}
+
+	// A flywheel can't be braked usefully, so the output never reverses
+	output = setpoint + ((error * config.shooterKp + integral) >> CONFIG_GAIN_SHIFT);
+	if (output > MAX_SPEED) {
+		output = MAX_SPEED;
+	} else if (output < 0) {
+		output = 0;
+	}
+
+	return (int16_t) output;
 }
 
 void shooter(int8_t sspeed){
-	// Linear filtering for gradual acceleration and reduced motor wear
-	int8_t sspeed2 = getfSpeed(SHOOTER_MOTOR_CHANNEL, -sspeed);
-	int8_t sspeed3 = getfSpeed(SHOOTER_MOTOR_CHANNEL2, sspeed);
-	motorSet (SHOOTER_MOTOR_CHANNEL , sspeed2);
-	motorSet (SHOOTER_MOTOR_CHANNEL2, sspeed3);
+	if (autotuneIsRunning()) {
+		return;
+	}
+
+	// The shared filter ramps the setpoint, which the velocity loop then holds once it is tuned
+	shooterSetpoint = mechanismsFilter(MECHANISM_SHOOTER, sspeed);
+	LATENCY_COMMAND(MECHANISM_SHOOTER, 0, shooterSetpoint);
+
+	if (config.shooterMaxVelocity > 0) {
+		setShooterMotors(controlShooter(shooterSetpoint));
+	} else {
+		setShooterMotors(shooterSetpoint);
+	}
+}
+
+void setShooterMotors(int8_t speed) {
+	mechanismsSetRaw(MECHANISM_SHOOTER, speed);
+}
+
+int8_t getShooterSetpoint(void) {
+	return shooterSetpoint;
 }
 
 void takeInFront(int8_t speed) {
-	int8_t fspeed = getfSpeed(FRONT_INTAKE_MOTOR_CHANNEL, -speed);
-	motorSet(FRONT_INTAKE_MOTOR_CHANNEL, fspeed);
+	mechanismsSetMotor(FRONT_INTAKE_MOTOR_CHANNEL, speed);
 }
 
 int8_t calculateShooterSpeed() {
-	float dist = ultrasonicGet(ultra) / 2.54;
+	struct RobotState state;
+	float dist;
+
+	robotstateGet(&state);
+	dist = state.range / (float) ODOMETRY_SCALE;
 	float speed = 1.11 * dist - 1.6;
+	int32_t aimHeading;
 
 	if (speed > MAX_SPEED) {
 		speed = MAX_SPEED;
@@ -84,5 +240,6 @@ int8_t calculateShooterSpeed() {
 		speed = 0;
 	}
 
-	return (int8_t) speed;
+	// The robot's velocity adds to the ball's, so the shot is corrected for it
+	return motioncompApply(&state, aimGetBearing(&state), (int8_t) speed, &aimHeading);
 }
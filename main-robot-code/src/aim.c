@@ -0,0 +1,100 @@
+#include "aim.h"
+
+#include "main.h"
+#include "config.h"
+#include "heading.h"
+#include "robotstate.h"
+#include "actions.h"
+#include "motioncomp.h"
+#include "trig.h"
+
+#define AIM_TOLERANCE (2 * HEADING_SCALE)	// on target within 2 degrees
+#define AIM_SETTLED_RATE 10	// degrees per second
+
+#define HALF_TURN (180 * HEADING_SCALE)
+
+static volatile int32_t goalHeading = 0;
+static volatile int32_t goalX = 0, goalY = 0;
+static volatile bool isGoalPositionKnown = false;
+
+// The heading error, wrapped so the robot always turns the short way
+static int32_t getError(const struct RobotState *state, int32_t target) {
+	int32_t error = (state->heading - target) % (2 * HALF_TURN);
+
+	if (error >= HALF_TURN) {
+		error -= 2 * HALF_TURN;
+	} else if (error < -HALF_TURN) {
+		error += 2 * HALF_TURN;
+	}
+
+	return error;
+}
+
+// The heading to aim at, led ahead of the goal to cancel out the robot's own motion
+static int32_t getTarget(const struct RobotState *state) {
+	int32_t target;
+
+	motioncompApply(state, aimGetBearing(state), getShooterSetpoint(), &target);
+	return target;
+}
+
+void aimSetGoalHeading(int32_t heading) {
+	goalHeading = heading;
+	isGoalPositionKnown = false;
+}
+
+void aimRecordGoalHeading(void) {
+	struct RobotState state;
+	int16_t degrees;
+
+	robotstateGet(&state);
+	goalHeading = state.heading;
+
+	// With a range to the goal, it can be placed on the field and aimed at from anywhere
+	isGoalPositionKnown = false;
+	if (state.range > 0) {
+		degrees = state.headingWrapped;
+		goalX = state.x - (((int32_t) state.range * trigSin(degrees)) >> TRIG_SHIFT);
+		goalY = state.y + (((int32_t) state.range * trigCos(degrees)) >> TRIG_SHIFT);
+		isGoalPositionKnown = true;
+	}
+}
+
+int32_t aimGetBearing(const struct RobotState *state) {
+	int16_t degrees;
+
+	if (!isGoalPositionKnown || (goalX == state->x && goalY == state->y)) {
+		return goalHeading;
+	}
+
+	// Heading 0 faces along the field's y axis, a quarter turn from where atan2() measures from
+	degrees = trigAtan2(goalY - state->y, goalX - state->x) - 90;
+	return (degrees < 0 ? degrees + 360 : degrees) * HEADING_SCALE;
+}
+
+int8_t aimGetRotation(void) {
+	struct RobotState state;
+	int32_t rotation;
+
+	robotstateGet(&state);
+	rotation = headingGetCorrection(getError(&state, getTarget(&state)), state.turnRate);
+
+	if (rotation > config.rotationMaxSpeed) {
+		rotation = config.rotationMaxSpeed;
+	} else if (rotation < -config.rotationMaxSpeed) {
+		rotation = -config.rotationMaxSpeed;
+	}
+
+	return (int8_t) rotation;
+}
+
+bool aimIsOnTarget(void) {
+	struct RobotState state;
+	int32_t error;
+
+	robotstateGet(&state);
+	error = getError(&state, getTarget(&state));
+
+	return error <= AIM_TOLERANCE && error >= -AIM_TOLERANCE
+			&& state.turnRate <= AIM_SETTLED_RATE && state.turnRate >= -AIM_SETTLED_RATE;
+}
@@ -37,6 +37,51 @@
 #include <stdbool.h>
 #include <math.h>
 #include "actions.h"
+#include "config.h"
+#include "mprofile.h"
+#include "watchdog.h"
+
+// Uncomment to make the moves below at the start of autonomous, once they are measured on the field
+//#define AUTO_MOVES
+
+#ifdef AUTO_MOVES
+#define DRIVE_TOP_SPEED 45.0f	// in/s at full speed, measured with tools/sim
+#define AUTO_MAX_VELOCITY 30.0f	// in/s
+#define AUTO_MAX_ACCEL 60.0f	// in/s^2
+#define AUTO_MAX_JERK 300.0f	// in/s^3
+
+struct AutoMove {
+	int8_t x, y;	// direction as percentages of full speed, like drive()'s vx and vy
+	float distance;	// in
+};
+
+// Moves made in order at the start of autonomous, while the flywheel spins up
+static const struct AutoMove moves[] = {
+	{ 0, 100, 24 }	// TODO: measure; 24 in straight forward
+};
+
+#define NUM_AUTO_MOVES (sizeof(moves) / sizeof(moves[0]))
+
+static struct MotionProfile profiles[NUM_AUTO_MOVES];
+#endif
+
+/*
+ * Computes the motion profile of every autonomous move. Called from initialize() so that no
+ * profile math is done during the timed period. A move too long to fit in a profile is reported
+ * on the debug terminal and skipped.
+ */
+void autonomousInit() {
+#ifdef AUTO_MOVES
+	uint8_t i;
+
+	for (i = 0; i < NUM_AUTO_MOVES; ++i) {
+		if (!mprofileInitSCurve(&profiles[i], moves[i].distance, AUTO_MAX_VELOCITY,
+				AUTO_MAX_ACCEL, AUTO_MAX_JERK, DRIVE_TOP_SPEED)) {
+			printf("auto: move %d does not fit in a motion profile\r\n", i + 1);
+		}
+	}
+#endif
+}
 
 /*
  * Runs the user autonomous code. This function will be started in its own task with the default
@@ -54,11 +99,36 @@
  */
 void autonomous() {
 	//lfilterClear();
-	int8_t shooterSpeed = shooterSpeedPresets[2];
+	int8_t shooterSpeed = config.shooterSpeedPresets[2];
 	int8_t n = 0;
+	unsigned long wakeTime = millis();
+#ifdef AUTO_MOVES
+	bool isInPosition = false;
+	int8_t speed;
+	uint8_t move = 0;
+	int16_t tick = 0;
+#else
+	bool isInPosition = true;
+#endif
 
 	while (true) {
-		if (abs(motorGet(SHOOTER_MOTOR_CHANNEL)) == shooterSpeed && abs(motorGet(SHOOTER_MOTOR_CHANNEL2)) == shooterSpeed) {
+#ifdef AUTO_MOVES
+		// Each move is a table lookup per cycle; the profiles were computed by autonomousInit()
+		if (move < NUM_AUTO_MOVES) {
+			speed = mprofileGet(&profiles[move], tick);
+			drive(speed * moves[move].x / 100, speed * moves[move].y / 100, 0, false);
+
+			if (mprofileIsDone(&profiles[move], ++tick)) {
+				++move;
+				tick = 0;
+			}
+		} else {
+			drive(0, 0, 0, false);
+			isInPosition = true;
+		}
+#endif
+
+		if (isInPosition && getShooterSetpoint() == shooterSpeed) {
 			if (n < 75) {
 				++n;
 			} else {
@@ -67,6 +137,7 @@ void autonomous() {
 			}
 		}
 		shooter(shooterSpeed);
-		delay(20);
+		watchdogFeed(WATCHDOG_CONTROL);
+		taskDelayUntil(&wakeTime, MPROFILE_PERIOD);
 	}
 }
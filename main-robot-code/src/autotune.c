@@ -0,0 +1,128 @@
+#include "autotune.h"
+
+#include "main.h"
+#include "actions.h"
+#include "config.h"
+#include "robotstate.h"
+#include "memdiag.h"
+#include <math.h>
+
+#define AUTOTUNE_PERIOD 20	// ms, the same as the control loop so the gains match it
+
+#define RELAY_BIAS 60	// shooter command the relay switches around
+#define RELAY_STEP 20
+#define RELAY_HYSTERESIS 5	// IME velocity units
+
+#define SETTLE_TIME 3000	// ms for the flywheel to reach a steady speed before the relay starts
+#define RELAY_TIMEOUT 15000	// ms
+#define NUM_SKIPPED_CYCLES 2	// oscillations left to settle before measuring
+#define NUM_MEASURED_CYCLES 4
+
+#define SAVE_PERIOD 100	// ms between checks for the robot being disabled
+
+static volatile bool isRunning = false;
+
+static int readVelocity(void) {
+	struct RobotState state;
+	robotstateGet(&state);
+	return state.shooterVelocity;
+}
+
+static void autotuneTask(void *ignore) {
+	unsigned long wakeTime = millis(), start, lastSwitch = 0, periodSum = 0;
+	int32_t velocitySum = 0, commandSum = 0, amplitudeSum = 0;
+	int16_t samples = 0;
+	int8_t cycles = 0, command = RELAY_BIAS + RELAY_STEP;
+	int setpoint, velocity, high = 0, low = 0;
+	float amplitude, period, ku, kp, ki;
+
+	// Find the steady speed at the bias command, averaged over the last second
+	setShooterMotors(RELAY_BIAS);
+	for (start = millis(); millis() - start < SETTLE_TIME;) {
+		if (millis() - start >= SETTLE_TIME - 1000) {
+			velocitySum += readVelocity();
+			++samples;
+		}
+		taskDelayUntil(&wakeTime, AUTOTUNE_PERIOD);
+	}
+	setpoint = velocitySum / samples;
+	velocitySum = samples = 0;
+
+	// Each switch up starts a new cycle; its peaks and length give one sample of the oscillation
+	for (start = millis(); millis() - start < RELAY_TIMEOUT
+			&& cycles < NUM_SKIPPED_CYCLES + NUM_MEASURED_CYCLES;) {
+		velocity = readVelocity();
+
+		if (velocity > high) {
+			high = velocity;
+		}
+		if (velocity < low) {
+			low = velocity;
+		}
+
+		if (command > RELAY_BIAS && velocity > setpoint + RELAY_HYSTERESIS) {
+			command = RELAY_BIAS - RELAY_STEP;
+		} else if (command < RELAY_BIAS && velocity < setpoint - RELAY_HYSTERESIS) {
+			command = RELAY_BIAS + RELAY_STEP;
+
+			if (cycles >= NUM_SKIPPED_CYCLES) {
+				periodSum += millis() - lastSwitch;
+				amplitudeSum += (high - low) / 2;
+			}
+
+			++cycles;
+			lastSwitch = millis();
+			high = low = velocity;
+		}
+
+		if (cycles >= NUM_SKIPPED_CYCLES) {
+			velocitySum += velocity;
+			commandSum += command;
+			++samples;
+		}
+
+		setShooterMotors(command);
+		taskDelayUntil(&wakeTime, AUTOTUNE_PERIOD);
+	}
+
+	setShooterMotors(0);
+
+	if (cycles == NUM_SKIPPED_CYCLES + NUM_MEASURED_CYCLES && commandSum > 0) {
+		amplitude = (float) amplitudeSum / NUM_MEASURED_CYCLES;
+		period = (float) periodSum / NUM_MEASURED_CYCLES;
+
+		// Ultimate gain of a relay with hysteresis, then Ziegler-Nichols PI gains per control cycle
+		ku = 4 * RELAY_STEP / (M_PI * sqrtf(fmaxf(amplitude * amplitude
+				- RELAY_HYSTERESIS * RELAY_HYSTERESIS, 1)));
+		kp = 0.45f * ku;
+		ki = kp * AUTOTUNE_PERIOD / (period / 1.2f);
+
+		configLock();
+		config.shooterMaxVelocity = velocitySum * MAX_SPEED / commandSum;
+		config.shooterKp = (int32_t) (kp * CONFIG_GAIN_ONE);
+		config.shooterKi = (int32_t) (ki * CONFIG_GAIN_ONE);
+		configUnlock();
+	}
+
+	isRunning = false;
+
+	// Flash writes stall the other tasks, so the gains are only saved once the robot is disabled
+	while (isEnabled()) {
+		delay(SAVE_PERIOD);
+	}
+	configSave();
+
+	taskDelete(NULL);
+}
+
+void autotuneStart(void) {
+	if (!isRunning) {
+		isRunning = true;
+		memdiagTaskCreate("autotune", autotuneTask, TASK_DEFAULT_STACK_SIZE, NULL,
+				TASK_PRIORITY_DEFAULT);
+	}
+}
+
+bool autotuneIsRunning(void) {
+	return isRunning;
+}
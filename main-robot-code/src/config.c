@@ -0,0 +1,104 @@
+#include "config.h"
+
+#include "crc.h"
+#include "controls.h"
+#include <stddef.h>
+
+#define CONFIG_FILE "config"
+#define CONFIG_MAGIC 0x5846	// "FX"
+
+#define CRC_LENGTH offsetof(struct Config, crc)
+#define WAIT_FOREVER ((unsigned long) -1)	// the kernel's MAX_DELAY
+
+struct Config config;
+
+static Mutex mutex = NULL;
+
+static const struct Config defaults = {
+	.magic = CONFIG_MAGIC,
+	.version = CONFIG_VERSION,
+	.size = sizeof(struct Config),
+
+	.shooterSpeedPresets = { 45, 55, 75 },
+
+	.driveNumFilterCycles = 12,
+	.intakeNumFilterCycles = 7,
+	.lifterNumFilterCycles = 8,
+	.shooterNumFilterCycles = 12,
+
+	.driveDeadband = 30,
+	.rotationDeadband = 8,
+	.rotationMaxSpeed = 63,
+	.preciseDriveExpo = 70,
+
+	.intakeSpeed = 127,
+	.lifterSpeed = 60,
+
+	.shooterMaxVelocity = 0,
+	.shooterKp = 0,
+	.shooterKi = 0,
+
+	.partnerRoles = (1 << CONTROLS_SHOOTER) | (1 << CONTROLS_LIFTER) | (1 << CONTROLS_INTAKE),
+
+	.currentBudget = 16
+};
+
+static bool isValid(void) {
+	return config.magic == CONFIG_MAGIC
+			&& config.version == CONFIG_VERSION
+			&& config.size == sizeof(struct Config)
+			&& config.crc == crc16(&config, CRC_LENGTH);
+}
+
+void configLoadDefaults(void) {
+	config = defaults;
+	config.crc = crc16(&config, CRC_LENGTH);
+}
+
+bool configLoad(void) {
+	FILE *file = fopen(CONFIG_FILE, "r");
+	bool isLoaded = false;
+
+	if (mutex == NULL) {
+		mutex = mutexCreate();
+	}
+
+	if (file != NULL) {
+		isLoaded = fread(&config, sizeof(struct Config), 1, file) == 1 && isValid();
+		fclose(file);
+	}
+
+	if (!isLoaded) {
+		configLoadDefaults();
+	}
+
+	return isLoaded;
+}
+
+bool configSave(void) {
+	FILE *file = fopen(CONFIG_FILE, "w");
+	bool isSaved = false;
+
+	configLock();
+	config.crc = crc16(&config, CRC_LENGTH);
+
+	if (file != NULL) {
+		isSaved = fwrite(&config, sizeof(struct Config), 1, file) == 1;
+		fclose(file);
+	}
+
+	configUnlock();
+	return isSaved;
+}
+
+void configLock(void) {
+	if (mutex != NULL) {
+		mutexTake(mutex, WAIT_FOREVER);
+	}
+}
+
+void configUnlock(void) {
+	if (mutex != NULL) {
+		mutexGive(mutex);
+	}
+}
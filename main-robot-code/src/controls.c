@@ -0,0 +1,203 @@
+#include "controls.h"
+
+#include "main.h"
+#include "config.h"
+#include "latency.h"
+#include <stdlib.h>
+
+#define NUM_SLOTS 2
+#define NUM_AXES 4
+#define FIRST_BUTTON_GROUP 5
+#define LAST_BUTTON_GROUP 8
+
+// Every button of groups 5 to 8 fits in one 16 bit mask, since JOY_* are already single bits
+#define BUTTON_BIT(group, button) ((uint16_t) (button) << (((group) - FIRST_BUTTON_GROUP) * 4))
+
+struct JoystickInput {
+	int8_t axes[NUM_AXES], prevAxes[NUM_AXES];
+	uint16_t buttons, prevButtons;
+	bool isConnected;
+};
+
+static const uint16_t roleButtons[CONTROLS_ROLE_LIMIT] = {
+	[CONTROLS_DRIVE] = BUTTON_BIT(CONTROL_BUTTON_GROUP, JOY_UP)
+			| BUTTON_BIT(CONTROL_BUTTON_GROUP, JOY_LEFT),
+	[CONTROLS_SHOOTER] = BUTTON_BIT(SHOOTER_ADJUST_BUTTON_GROUP, JOY_UP)
+			| BUTTON_BIT(SHOOTER_ADJUST_BUTTON_GROUP, JOY_DOWN)
+			| BUTTON_BIT(CONTROL_BUTTON_GROUP, JOY_DOWN)
+			| BUTTON_BIT(CONTROL_BUTTON_GROUP, JOY_RIGHT),
+	[CONTROLS_LIFTER] = BUTTON_BIT(LIFTER_BUTTON_GROUP, JOY_UP)
+			| BUTTON_BIT(LIFTER_BUTTON_GROUP, JOY_DOWN),
+	[CONTROLS_INTAKE] = BUTTON_BIT(INTAKE_BUTTON_GROUP, JOY_UP)
+			| BUTTON_BIT(INTAKE_BUTTON_GROUP, JOY_DOWN)
+			| BUTTON_BIT(INTAKE_BUTTON_GROUP, JOY_LEFT)
+			| BUTTON_BIT(INTAKE_BUTTON_GROUP, JOY_RIGHT)
+};
+
+static struct JoystickInput inputs[NUM_SLOTS];	// zeroed like any static, so nothing is pressed at first
+static int8_t slots[CONTROLS_ROLE_LIMIT] = { JOYSTICK_SLOT, JOYSTICK_SLOT, JOYSTICK_SLOT,
+		JOYSTICK_SLOT };
+
+// Groups 5 and 6 only have up and down buttons; the others read as released
+static void readJoystick(unsigned char slot, struct JoystickInput *input) {
+	int8_t group, axis;
+	uint8_t button;
+
+	input->prevButtons = input->buttons;
+	input->buttons = 0;
+
+	for (axis = 0; axis < NUM_AXES; ++axis) {
+		input->prevAxes[axis] = input->axes[axis];
+		input->axes[axis] = 0;
+	}
+
+	input->isConnected = isJoystickConnected(slot);
+	if (!input->isConnected) {
+		return;
+	}
+
+	for (axis = 0; axis < NUM_AXES; ++axis) {
+		input->axes[axis] = (int8_t) joystickGetAnalog(slot, axis + 1);
+	}
+
+	for (group = FIRST_BUTTON_GROUP; group <= LAST_BUTTON_GROUP; ++group) {
+		for (button = JOY_DOWN; button <= JOY_RIGHT; button <<= 1) {
+			if (joystickGetDigital(slot, group, button)) {
+				input->buttons |= BUTTON_BIT(group, button);
+			}
+		}
+	}
+}
+
+#ifdef PROFILER
+
+static const int8_t roleMechanisms[CONTROLS_ROLE_LIMIT] = {
+	[CONTROLS_DRIVE] = MECHANISM_DRIVE,
+	[CONTROLS_SHOOTER] = MECHANISM_SHOOTER,
+	[CONTROLS_LIFTER] = MECHANISM_LIFTER,
+	[CONTROLS_INTAKE] = MECHANISM_INTAKE
+};
+
+// Whether a role's inputs changed since the previous cycle, on the joystick now controlling it
+static bool isChanged(int8_t role) {
+	const struct JoystickInput *input = &inputs[slots[role] - 1];
+	int8_t axis;
+
+	if ((input->buttons ^ input->prevButtons) & roleButtons[role]) {
+		return true;
+	}
+
+	if (role == CONTROLS_DRIVE) {
+		for (axis = 0; axis < NUM_AXES; ++axis) {
+			if (input->axes[axis] != input->prevAxes[axis]) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+#endif
+
+static bool isDriverUsing(enum ControlsRole role) {
+	const struct JoystickInput *driver = &inputs[JOYSTICK_SLOT - 1];
+	int8_t axis;
+
+	if (driver->buttons & roleButtons[role]) {
+		return true;
+	}
+
+	if (role == CONTROLS_DRIVE) {
+		for (axis = 0; axis < NUM_AXES; ++axis) {
+			if (abs(driver->axes[axis]) >= CONTROLS_ACTIVE_THRESHOLD) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void controlsUpdate(void) {
+	int8_t role;
+
+	LATENCY_TICK();
+	readJoystick(JOYSTICK_SLOT, &inputs[JOYSTICK_SLOT - 1]);
+	readJoystick(PARTNER_JOYSTICK_SLOT, &inputs[PARTNER_JOYSTICK_SLOT - 1]);
+
+	for (role = 0; role < CONTROLS_ROLE_LIMIT; ++role) {
+		if (inputs[PARTNER_JOYSTICK_SLOT - 1].isConnected && (config.partnerRoles & (1 << role))
+				&& !isDriverUsing((enum ControlsRole) role)) {
+			slots[role] = PARTNER_JOYSTICK_SLOT;
+		} else {
+			slots[role] = JOYSTICK_SLOT;
+		}
+
+#ifdef PROFILER
+		if (isChanged(role)) {
+			LATENCY_INPUT(roleMechanisms[role]);
+		}
+#endif
+	}
+}
+
+int8_t controlsGetSlot(enum ControlsRole role) {
+	return (role >= 0 && role < CONTROLS_ROLE_LIMIT) ? slots[role] : JOYSTICK_SLOT;
+}
+
+int8_t controlsGetAxis(enum ControlsRole role, int8_t axis) {
+	if (axis < 1 || axis > NUM_AXES) {
+		return 0;
+	}
+
+	return inputs[controlsGetSlot(role) - 1].axes[axis - 1];
+}
+
+enum ButtonState controlsGetButton(enum ControlsRole role, int8_t buttonGroup, int8_t button) {
+	const struct JoystickInput *input = &inputs[controlsGetSlot(role) - 1];
+	uint16_t bit;
+	bool isDown, wasDown;
+
+	if (buttonGroup < FIRST_BUTTON_GROUP || buttonGroup > LAST_BUTTON_GROUP
+			|| (button != JOY_DOWN && button != JOY_LEFT && button != JOY_UP
+					&& button != JOY_RIGHT)) {
+		return NO_STATE;
+	}
+
+	bit = BUTTON_BIT(buttonGroup, button);
+	isDown = (input->buttons & bit) != 0;
+	wasDown = (input->prevButtons & bit) != 0;
+
+	if (isDown && wasDown) {
+		return BUTTON_HELD;
+	} else if (isDown) {
+		return BUTTON_PRESSED;
+	} else if (wasDown) {
+		return BUTTON_RELEASED;
+	}
+
+	return BUTTON_NOT_PRESSED;
+}
+
+bool controlsIsDown(enum ControlsRole role, int8_t buttonGroup, int8_t button) {
+	enum ButtonState state = controlsGetButton(role, buttonGroup, button);
+	return state == BUTTON_PRESSED || state == BUTTON_HELD;
+}
+
+bool controlsGetSnapshot(int8_t slot, int8_t axes[4], uint16_t *buttons) {
+	const struct JoystickInput *input;
+	int8_t axis;
+
+	if (slot != JOYSTICK_SLOT && slot != PARTNER_JOYSTICK_SLOT) {
+		return false;
+	}
+
+	input = &inputs[slot - 1];
+	for (axis = 0; axis < NUM_AXES; ++axis) {
+		axes[axis] = input->axes[axis];
+	}
+	*buttons = input->buttons;
+
+	return input->isConnected;
+}
@@ -0,0 +1,19 @@
+#include "crc.h"
+
+#define CRC_POLYNOMIAL 0x1021
+#define CRC_INITIAL 0xFFFF
+
+uint16_t crc16(const void *data, size_t length) {
+	const uint8_t *byte = data;
+	uint16_t crc = CRC_INITIAL;
+	int8_t bit;
+
+	while (length-- > 0) {
+		crc ^= (uint16_t) *byte++ << 8;
+		for (bit = 0; bit < 8; ++bit) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ CRC_POLYNOMIAL : crc << 1;
+		}
+	}
+
+	return crc;
+}
@@ -0,0 +1,112 @@
+#include "heading.h"
+
+#include "main.h"
+#include "memdiag.h"
+
+#define HEADING_PERIOD 10	// ms
+#define CALIBRATION_TIME 1000	// ms
+
+#define BIAS_SHIFT 16	// bias is stored in 1/65536 of a degree per period
+#define BIAS_TRACKING_SHIFT 3	// each stationary window moves the bias 1/8 of the way
+#define RATE_SHIFT 3	// the turn rate is averaged over roughly 8 periods
+
+#define STATIONARY_WINDOW 500	// ms the drive must stay idle for a bias measurement
+#define STATIONARY_DRIFT 2	// largest gyro change over a window that still counts as drift
+
+#define FULL_TURN (360 * HEADING_SCALE)
+
+static Gyro sensor = NULL;
+static int32_t bias = 0;
+static int64_t drift = 0;
+static int32_t rateSum = 0;
+static int32_t windowStart = 0;
+static int16_t windowCycles = 0;
+
+static int16_t wrappedUnits = 0;
+
+static volatile int32_t heading = 0;
+static volatile int16_t wrapped = 0;
+static volatile int16_t rate = 0;
+
+static bool isDriveIdle(void) {
+	return motorGet(FRONT_LEFT_MOTOR_CHANNEL) == 0 && motorGet(FRONT_RIGHT_MOTOR_CHANNEL) == 0
+			&& motorGet(BACK_LEFT_MOTOR_CHANNEL) == 0 && motorGet(BACK_RIGHT_MOTOR_CHANNEL) == 0;
+}
+
+static void update(void) {
+	int32_t raw = gyroGet(sensor);
+	int32_t prev = heading, next, delta;
+
+	// The gyro only reports whole degrees, so the drift is measured over whole windows in which
+	// the drive was idle and the gyro barely moved
+	if (isDriveIdle()) {
+		if (++windowCycles == STATIONARY_WINDOW / HEADING_PERIOD) {
+			if (abs(raw - windowStart) <= STATIONARY_DRIFT) {
+				bias += ((raw - windowStart) * (1 << BIAS_SHIFT) / windowCycles - bias)
+						>> BIAS_TRACKING_SHIFT;
+			}
+			windowStart = raw;
+			windowCycles = 0;
+		}
+	} else {
+		windowStart = raw;
+		windowCycles = 0;
+	}
+
+	drift += bias;
+	next = raw * HEADING_SCALE - (int32_t) ((drift * HEADING_SCALE) >> BIAS_SHIFT);
+	delta = next - prev;
+
+	rateSum += delta - (rateSum >> RATE_SHIFT);
+
+	// The heading only moves a few degrees per period, so wrapping it never needs a modulo
+	wrappedUnits += delta;
+	while (wrappedUnits >= FULL_TURN) {
+		wrappedUnits -= FULL_TURN;
+	}
+	while (wrappedUnits < 0) {
+		wrappedUnits += FULL_TURN;
+	}
+
+	heading = next;
+	wrapped = wrappedUnits / HEADING_SCALE;
+	rate = rateSum * (1000 / HEADING_PERIOD) / (HEADING_SCALE << RATE_SHIFT);
+}
+
+static void headingTask(void *ignore) {
+	unsigned long wakeTime = millis();
+
+	while (true) {
+		update();
+		taskDelayUntil(&wakeTime, HEADING_PERIOD);
+	}
+}
+
+void headingInit(Gyro gyro) {
+	if (gyro != NULL && sensor == NULL) {
+		sensor = gyro;
+
+		windowStart = gyroGet(sensor);
+		delay(CALIBRATION_TIME);
+		bias = (gyroGet(sensor) - windowStart) * (1 << BIAS_SHIFT)
+				/ (CALIBRATION_TIME / HEADING_PERIOD);
+
+		gyroReset(sensor);
+		windowStart = 0;
+
+		memdiagTaskCreate("heading", headingTask, TASK_DEFAULT_STACK_SIZE, NULL,
+				TASK_PRIORITY_DEFAULT + 1);
+	}
+}
+
+int32_t headingGet(void) {
+	return heading;
+}
+
+int16_t headingGetWrapped(void) {
+	return wrapped;
+}
+
+int16_t headingGetRate(void) {
+	return rate;
+}
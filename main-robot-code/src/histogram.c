@@ -0,0 +1,53 @@
+#include "histogram.h"
+
+void histogramInit(struct Histogram *histogram, uint8_t bucketShift) {
+	int8_t i;
+
+	for (i = 0; i < HISTOGRAM_NUM_BUCKETS; ++i) {
+		histogram->counts[i] = 0;
+	}
+
+	histogram->total = 0;
+	histogram->min = UINT32_MAX;
+	histogram->max = 0;
+	histogram->bucketShift = bucketShift;
+}
+
+void histogramAdd(struct Histogram *histogram, uint32_t value) {
+	uint32_t bucket = value >> histogram->bucketShift;
+
+	if (bucket >= HISTOGRAM_NUM_BUCKETS) {
+		bucket = HISTOGRAM_NUM_BUCKETS - 1;
+	}
+
+	++histogram->counts[bucket];
+	++histogram->total;
+
+	if (value < histogram->min) {
+		histogram->min = value;
+	}
+
+	if (value > histogram->max) {
+		histogram->max = value;
+	}
+}
+
+uint32_t histogramPercentile(const struct Histogram *histogram, int8_t percent) {
+	uint32_t target = (histogram->total * percent + 99) / 100;
+	uint32_t sum = 0, edge;
+	int8_t i;
+
+	if (histogram->total == 0) {
+		return 0;
+	}
+
+	for (i = 0; i < HISTOGRAM_NUM_BUCKETS - 1; ++i) {
+		sum += histogram->counts[i];
+		if (sum >= target) {
+			break;
+		}
+	}
+
+	edge = ((uint32_t) i + 1) << histogram->bucketShift;
+	return (i == HISTOGRAM_NUM_BUCKETS - 1 || edge > histogram->max) ? histogram->max : edge;
+}
@@ -34,12 +34,21 @@
 
 #include "main.h"
 
-#include "lfilter.h"
+#include "config.h"
+#include "mechanisms.h"
+#include "opcontrol.h"
+#include "heading.h"
+#include "sensors.h"
+#include "power.h"
+#include "watchdog.h"
+#include "wheelctl.h"
+#include "lcdmenu.h"
+#include "profiler.h"
+#include "telemetry.h"
 
-#define DRIVE_NUM_FILTER_CYCLES 12
-#define INTAKE_NUM_FILTER_CYCLES 7
-#define LIFTER_NUM_FILTER_CYCLES 8
-#define SHOOTER_NUM_FILTER_CYCLES 12
+#define LCD_PORT uart1
+#define TELEMETRY_PORT uart2
+#define TELEMETRY_BAUD 115200
 
 #define GYRO_PORT 1
 #define GYRO_MULTIPLIER 0
@@ -49,8 +58,6 @@
 Gyro gyro;
 Ultrasonic ultra;
 
-int8_t shooterSpeedPresets[NUM_SHOOTER_SPEED_PRESETS] = { 45, 55, 75 };
-
 /*
  * Runs pre-initialization code. This function will be started in kernel mode one time while the
  * VEX Cortex is starting up. As the scheduler is still paused, most API functions will fail.
@@ -60,6 +67,7 @@ int8_t shooterSpeedPresets[NUM_SHOOTER_SPEED_PRESETS] = { 45, 55, 75 };
  * configure a UART port (usartOpen()) but cannot set up an LCD (lcdInit()).
  */
 void initializeIO() {
+	usartInit(TELEMETRY_PORT, TELEMETRY_BAUD, SERIAL_8N1);
 }
 
 /*
@@ -76,20 +84,25 @@ void initializeIO() {
  * can be implemented in this task if desired.
  */
 void initialize() {
+	configLoad();
+
 	gyro = gyroInit(GYRO_PORT, GYRO_MULTIPLIER);
+	headingInit(gyro);
 	ultra = ultrasonicInit(ULTRASONIC_ECHO_PORT, ULTRASONIC_PING_PORT);
+	imeInitializeAll();
+	sensorsInit();
+	powerInit();
+	watchdogInit();
+	wheelctlInit();
 
-	lfilterInit(FRONT_LEFT_MOTOR_CHANNEL, DRIVE_NUM_FILTER_CYCLES);
-	lfilterInit(FRONT_RIGHT_MOTOR_CHANNEL, DRIVE_NUM_FILTER_CYCLES);
-	lfilterInit(BACK_LEFT_MOTOR_CHANNEL, DRIVE_NUM_FILTER_CYCLES);
-	lfilterInit(BACK_RIGHT_MOTOR_CHANNEL, DRIVE_NUM_FILTER_CYCLES);
+	mechanismsInit();
+	autonomousInit();
 
-	lfilterInit(FRONT_INTAKE_MOTOR_CHANNEL, INTAKE_NUM_FILTER_CYCLES);
-	lfilterInit(INTERNAL_INTAKE_MOTOR_CHANNEL, INTAKE_NUM_FILTER_CYCLES);
-	lfilterInit(LIFTER_MOTOR_CHANNEL, LIFTER_NUM_FILTER_CYCLES);
+	opcontrolInit();
 
-	lfilterInit(SHOOTER_MOTOR_CHANNEL, SHOOTER_NUM_FILTER_CYCLES);
-	lfilterInit(SHOOTER_MOTOR_CHANNEL2, SHOOTER_NUM_FILTER_CYCLES);
+	lcdmenuInit(LCD_PORT);
+	profilerInit();
+	telemetryInit(TELEMETRY_PORT);
 
 //	delay(2000);
 }
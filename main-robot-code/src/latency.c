@@ -0,0 +1,125 @@
+#include "latency.h"
+
+#ifdef PROFILER
+
+#include "main.h"
+#include "histogram.h"
+
+#define NUM_CHANNELS 10
+#define RESPONSE_BUCKET_SHIFT 9	// 512 us buckets, up to about 16 ms
+#define SETTLE_BUCKET_SHIFT 13	// 8 ms buckets, up to about 260 ms
+#define LATENCY_TIMEOUT 1000000	// us; inputs inside a deadband never move the motors
+
+struct Measurement {
+	bool isPending, hasResponded;
+	unsigned long inputTime, lastChangeTime;
+};
+
+static struct Histogram responses[NUM_MECHANISMS], settles[NUM_MECHANISMS];
+static struct Measurement measurements[NUM_MECHANISMS];
+static int16_t outputs[NUM_CHANNELS];
+static int16_t commands[NUM_MECHANISMS][LATENCY_MAX_COMMANDS];
+static unsigned long prevTickTime = 0;
+
+#define MECHANISM_NAME(mechanism, field, filterChannel, priority) #mechanism,
+
+static const char *mechanismNames[NUM_MECHANISMS] = { MECHANISM_TABLE(MECHANISM_NAME) };
+
+void latencyTick(void) {
+	unsigned long now = micros();
+	struct Measurement *m;
+	int8_t i;
+
+	for (i = 0; i < NUM_MECHANISMS; ++i) {
+		m = &measurements[i];
+
+		if (!m->isPending) {
+			continue;
+		}
+
+		if (m->hasResponded && m->lastChangeTime < prevTickTime) {
+			histogramAdd(&settles[i], m->lastChangeTime - m->inputTime);
+			m->isPending = false;
+		} else if (now - m->inputTime > LATENCY_TIMEOUT) {
+			m->isPending = false;
+		}
+	}
+
+	prevTickTime = now;
+}
+
+void latencyRecordInput(int8_t mechanism) {
+	struct Measurement *m = &measurements[mechanism];
+
+	m->isPending = true;
+	m->hasResponded = false;
+	m->inputTime = micros();
+}
+
+// Mechanisms measured on their commands, whose motor outputs are ignored
+static bool isClosedLoop(int8_t mechanism) {
+	return mechanism == MECHANISM_DRIVE || mechanism == MECHANISM_SHOOTER;
+}
+
+static void recordChange(int8_t mechanism) {
+	struct Measurement *m = &measurements[mechanism];
+
+	if (m->isPending) {
+		m->lastChangeTime = micros();
+
+		if (!m->hasResponded) {
+			histogramAdd(&responses[mechanism], m->lastChangeTime - m->inputTime);
+			m->hasResponded = true;
+		}
+	}
+}
+
+void latencyRecordOutput(unsigned char channel, int16_t speed) {
+	int8_t mechanism = mechanismsGetMechanism(channel);
+
+	if (mechanism < 0 || isClosedLoop(mechanism) || outputs[channel - 1] == speed) {
+		return;
+	}
+
+	outputs[channel - 1] = speed;
+	recordChange(mechanism);
+}
+
+void latencyRecordCommand(int8_t mechanism, int8_t index, int16_t command) {
+	if (index < 0 || index >= LATENCY_MAX_COMMANDS || commands[mechanism][index] == command) {
+		return;
+	}
+
+	commands[mechanism][index] = command;
+	recordChange(mechanism);
+}
+
+void latencyClear(void) {
+	int8_t i;
+
+	for (i = 0; i < NUM_MECHANISMS; ++i) {
+		histogramInit(&responses[i], RESPONSE_BUCKET_SHIFT);
+		histogramInit(&settles[i], SETTLE_BUCKET_SHIFT);
+		measurements[i].isPending = false;
+	}
+}
+
+static void printRow(const char *name, const char *kind, const struct Histogram *h) {
+	printf("%-17s %-8s %6lu %8lu %8lu %8lu %8lu\r\n", name, kind, (unsigned long) h->total,
+			(unsigned long) (h->total > 0 ? h->min : 0), (unsigned long) h->max,
+			(unsigned long) histogramPercentile(h, 50),
+			(unsigned long) histogramPercentile(h, 90));
+}
+
+void latencyPrint(void) {
+	int8_t i;
+
+	printf("mechanism         to        count      min      max      p50      p90\r\n");
+
+	for (i = 0; i < NUM_MECHANISMS; ++i) {
+		printRow(mechanismNames[i], "response", &responses[i]);
+		printRow(mechanismNames[i], "settle", &settles[i]);
+	}
+}
+
+#endif
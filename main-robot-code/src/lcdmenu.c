@@ -0,0 +1,191 @@
+#include "lcdmenu.h"
+
+#include "main.h"
+#include "config.h"
+#include "robotstate.h"
+#include "autotune.h"
+#include "aim.h"
+#include "memdiag.h"
+#include "watchdog.h"
+#include "controls.h"
+#include "traction.h"
+#include "power.h"
+#include <string.h>
+
+#define MENU_PERIOD 50	// ms between button polls
+#define REFRESH_CYCLES 5	// live values are redrawn every 5 polls
+
+#define LINE_LENGTH 16
+
+struct MenuItem {
+	const char *name;
+	int8_t *value;	// the config field being tuned, or NULL for a live value
+	int8_t min, max;
+	int (*read)(void);	// reads a live value
+	void (*run)(void);	// started by the center button instead of editing
+};
+
+static int readDistance(void) {
+	struct RobotState state;
+	robotstateGet(&state);
+	return state.range / ODOMETRY_SCALE;
+}
+
+static int readFlywheel(void) {
+	struct RobotState state;
+	robotstateGet(&state);
+	return state.shooterVelocity;
+}
+
+static int readLoopTime(void) {
+	return (int) loopTime;
+}
+
+static int readHeading(void) {
+	struct RobotState state;
+	robotstateGet(&state);
+	return state.headingWrapped;
+}
+
+static int readStackFree(void) {
+	return memdiagGetMinFree();
+}
+
+static int readOverruns(void) {
+	return watchdogGetOverruns(WATCHDOG_CONTROL) + watchdogGetOverruns(WATCHDOG_SENSORS);
+}
+
+static int readTraction(void) {
+	return tractionGetPercent();
+}
+
+static int readDemand(void) {
+	return powerGetDemand() / 1000;
+}
+
+static int readTuning(void) {
+	return autotuneIsRunning();
+}
+
+static const struct MenuItem items[] = {
+	{ "Distance (in)", NULL, 0, 0, readDistance, NULL },
+	{ "Flywheel (IME)", NULL, 0, 0, readFlywheel, NULL },
+	{ "Loop time (us)", NULL, 0, 0, readLoopTime, NULL },
+	{ "Heading (deg)", NULL, 0, 0, readHeading, NULL },
+	{ "Stack free (wd)", NULL, 0, 0, readStackFree, NULL },
+	{ "Overruns", NULL, 0, 0, readOverruns, NULL },
+	{ "Traction (%)", NULL, 0, 0, readTraction, NULL },
+	{ "Demand (A)", NULL, 0, 0, readDemand, NULL },
+	{ "Preset 1", &config.shooterSpeedPresets[0], 0, MAX_SPEED, NULL, NULL },
+	{ "Preset 2", &config.shooterSpeedPresets[1], 0, MAX_SPEED, NULL, NULL },
+	{ "Preset 3", &config.shooterSpeedPresets[2], 0, MAX_SPEED, NULL, NULL },
+	{ "Drive ramp", &config.driveNumFilterCycles, 1, 12, NULL, NULL },
+	{ "Intake filter", &config.intakeNumFilterCycles, 1, 12, NULL, NULL },
+	{ "Lifter filter", &config.lifterNumFilterCycles, 1, 12, NULL, NULL },
+	{ "Shooter filter", &config.shooterNumFilterCycles, 1, 12, NULL, NULL },
+	{ "Budget (A)", &config.currentBudget, 4, 40, NULL, NULL },
+	{ "Partner roles", &config.partnerRoles, 0, (1 << CONTROLS_ROLE_LIMIT) - 1, NULL, NULL },
+	{ "Set goal (deg)", NULL, 0, 0, readHeading, aimRecordGoalHeading },
+	{ "Tune shooter", NULL, 0, 0, readTuning, autotuneStart }
+};
+
+#define NUM_ITEMS ((int8_t) (sizeof(items) / sizeof(items[0])))
+
+static FILE *port;
+static char shown[2][LINE_LENGTH + 1];
+
+// Only lines whose text changed are sent, since every update is a serial transfer
+static void setLine(unsigned char line, const char *text) {
+	if (strcmp(shown[line - 1], text) != 0) {
+		strcpy(shown[line - 1], text);
+		lcdSetText(port, line, text);
+	}
+}
+
+static void draw(const struct MenuItem *item, bool isEditing) {
+	char text[LINE_LENGTH + 1];
+
+	setLine(1, item->name);
+
+	if (item->value == NULL) {
+		snprintf(text, sizeof(text), "%d", item->read());
+	} else if (isEditing) {
+		snprintf(text, sizeof(text), "< %d >", *item->value);
+	} else {
+		snprintf(text, sizeof(text), "%d", *item->value);
+	}
+
+	setLine(2, text);
+}
+
+// Filter lengths are reapplied after every edit; lengths that didn't change are left alone
+static void edit(const struct MenuItem *item, int8_t step) {
+	int16_t value = *item->value + step;
+
+	if (value >= item->min && value <= item->max) {
+		configLock();
+		*item->value = (int8_t) value;
+		configUnlock();
+
+		mechanismsApplyFilterCycles();
+	}
+}
+
+static void menuTask(void *ignore) {
+	unsigned int buttons, prevButtons = 0, pressed;
+	unsigned long wakeTime = millis();
+	int8_t index = 0, refresh = REFRESH_CYCLES;
+	bool isEditing = false, isDirty = false;
+	const struct MenuItem *item;
+
+	while (true) {
+		buttons = lcdReadButtons(port);
+		pressed = buttons & ~prevButtons;
+		prevButtons = buttons;
+		item = &items[index];
+
+		if (pressed & LCD_BTN_CENTER) {
+			if (item->run != NULL) {
+				item->run();
+			} else if (item->value != NULL) {
+				isEditing = !isEditing;
+			}
+		} else if (isEditing) {
+			if (pressed & LCD_BTN_LEFT) {
+				edit(item, -1);
+				isDirty = true;
+			} else if (pressed & LCD_BTN_RIGHT) {
+				edit(item, 1);
+				isDirty = true;
+			}
+		} else if (pressed & LCD_BTN_LEFT) {
+			index = (index > 0) ? index - 1 : NUM_ITEMS - 1;
+		} else if (pressed & LCD_BTN_RIGHT) {
+			index = (index < NUM_ITEMS - 1) ? index + 1 : 0;
+		}
+
+		if (pressed || ++refresh >= REFRESH_CYCLES) {
+			draw(&items[index], isEditing);
+			refresh = 0;
+		}
+
+		// Flash writes stall the other tasks, so changes are only saved once the robot is disabled
+		if (isDirty && !isEditing && !isEnabled()) {
+			configSave();
+			isDirty = false;
+		}
+
+		taskDelayUntil(&wakeTime, MENU_PERIOD);
+	}
+}
+
+void lcdmenuInit(FILE *lcdPort) {
+	port = lcdPort;
+
+	lcdInit(port);
+	lcdClear(port);
+	lcdSetBacklight(port, true);
+
+	memdiagTaskCreate("lcdmenu", menuTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_LOWEST);
+}
@@ -26,6 +26,27 @@ void lfilterInit(const int8_t channel, int8_t numfCycles) {
 	}
 }
 
+// Uses its own indices rather than ch and cy so that it can be called from another task
+void lfilterSetCycles(const int8_t channel, int8_t numfCycles) {
+	int8_t i, j;
+
+	if (channel > 0 && channel <= MOTOR_LIMIT && chindex[channel - 1] != -1) {
+		i = chindex[channel - 1];
+
+		if (numfCycles > FILTER_CYCLE_LIMIT) {
+			numfCycles = FILTER_CYCLE_LIMIT;
+		} else if (numfCycles < 1) {
+			numfCycles = 1;
+		}
+
+		for (j = fcycles[i]; j < numfCycles; ++j) {
+			data[i][j] = data[i][0];
+		}
+
+		fcycles[i] = numfCycles;
+	}
+}
+
 int8_t getfSpeed(const int8_t channel, int16_t speed) {
 	int16_t fspeed = 0;
 
@@ -0,0 +1,31 @@
+#include "mechanisms.h"
+
+#include "main.h"
+#include "config.h"
+
+#define FILTER_CYCLES_FIELD(mechanism, field, filterChannel, priority) &config.field,
+
+// Members of a mechanism with a shared filter don't get filters of their own, and NO_FILTER
+// matches no channel
+#define HAS_FILTER(channel, mechanism) (mechanismsGetFilterChannel(mechanism) == 0 \
+		|| mechanismsGetFilterChannel(mechanism) == channel)
+
+#define MOTOR_FILTER_INIT(name, channel, isInverted, trim, mechanism) \
+	if (HAS_FILTER(channel, mechanism)) { \
+		lfilterInit(channel, *filterCycles[mechanism]); \
+	}
+
+#define MOTOR_FILTER_UPDATE(name, channel, isInverted, trim, mechanism) \
+	if (HAS_FILTER(channel, mechanism)) { \
+		lfilterSetCycles(channel, *filterCycles[mechanism]); \
+	}
+
+static int8_t *const filterCycles[NUM_MECHANISMS] = { MECHANISM_TABLE(FILTER_CYCLES_FIELD) };
+
+void mechanismsInit(void) {
+	MOTOR_TABLE(MOTOR_FILTER_INIT)
+}
+
+void mechanismsApplyFilterCycles(void) {
+	MOTOR_TABLE(MOTOR_FILTER_UPDATE)
+}
@@ -0,0 +1,115 @@
+#include "memdiag.h"
+
+#include <string.h>
+
+#define STACK_PAINT 0xA5A5A5A5
+
+// Words left unpainted below the wrapper's frame, covering its own locals and an interrupt frame
+#define PAINT_GAP 32
+
+// Words the kernel may already have used above the wrapper's frame when the task starts
+#define ENTRY_MARGIN 16
+
+struct TaskRecord {
+	const char *name;
+	TaskCode taskCode;
+	void *parameters;
+	unsigned int stackDepth;
+	volatile uint32_t *bottom;	// lowest painted word; NULL until the task has painted its stack
+	uint16_t numPainted;
+};
+
+static struct TaskRecord records[MEMDIAG_TASK_LIMIT];
+static int8_t numRecords = 0;
+
+// Runs at the start of every monitored task, painting everything below its own frame
+static void paintedTask(void *recordPointer) {
+	struct TaskRecord *record = recordPointer;
+	volatile uint32_t marker = STACK_PAINT;
+	volatile uint32_t *top = &marker - PAINT_GAP;
+	volatile uint32_t *bottom = &marker - record->stackDepth + ENTRY_MARGIN;
+	volatile uint32_t *p;
+
+	for (p = bottom; p < top; ++p) {
+		*p = STACK_PAINT;
+	}
+
+	record->numPainted = top - bottom;
+	record->bottom = bottom;
+
+	record->taskCode(record->parameters);
+}
+
+static struct TaskRecord *findRecord(const char *name) {
+	int8_t i;
+
+	for (i = 0; i < numRecords; ++i) {
+		if (strcmp(records[i].name, name) == 0) {
+			return &records[i];
+		}
+	}
+
+	return (numRecords < MEMDIAG_TASK_LIMIT) ? &records[numRecords++] : NULL;
+}
+
+// Painted words at the bottom of the stack that are still intact
+static int16_t countFree(const struct TaskRecord *record) {
+	int16_t count = 0;
+
+	while (count < record->numPainted && record->bottom[count] == STACK_PAINT) {
+		++count;
+	}
+
+	return count;
+}
+
+TaskHandle memdiagTaskCreate(const char *name, TaskCode taskCode, unsigned int stackDepth,
+		void *parameters, unsigned int priority) {
+	struct TaskRecord *record;
+
+	if (stackDepth <= PAINT_GAP + ENTRY_MARGIN || (record = findRecord(name)) == NULL) {
+		return taskCreate(taskCode, stackDepth, parameters, priority);
+	}
+
+	record->name = name;
+	record->taskCode = taskCode;
+	record->parameters = parameters;
+	record->stackDepth = stackDepth;
+	record->bottom = NULL;
+
+	return taskCreate(paintedTask, stackDepth, record, priority);
+}
+
+int16_t memdiagGetMinFree(void) {
+	int16_t free, minFree = -1;
+	int8_t i;
+
+	for (i = 0; i < numRecords; ++i) {
+		if (records[i].bottom != NULL) {
+			free = countFree(&records[i]);
+			if (minFree < 0 || free < minFree) {
+				minFree = free;
+			}
+		}
+	}
+
+	return minFree;
+}
+
+void memdiagPrint(void) {
+	const struct TaskRecord *record;
+	int16_t free;
+	int8_t i;
+
+	printf("task          stack     used     free\r\n");
+
+	for (i = 0; i < numRecords; ++i) {
+		record = &records[i];
+
+		if (record->bottom != NULL) {
+			free = countFree(record);
+			printf("%-10s %8u %8u %8d\r\n", record->name, record->stackDepth,
+					record->stackDepth - free, free);
+		}
+	}
+}
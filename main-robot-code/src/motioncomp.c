@@ -0,0 +1,75 @@
+#include "motioncomp.h"
+
+#include "main.h"
+#include "heading.h"
+#include "trig.h"
+
+// Horizontal ball speed per unit of shooter speed, in 1/ODOMETRY_SCALE in/s; about 1.7 in/s
+#define BALL_SPEED_PER_UNIT 27
+
+#define UNITS_PER_RADIAN (57 * HEADING_SCALE + HEADING_SCALE * 3 / 10)
+#define MAX_AIM_OFFSET (30 * HEADING_SCALE)
+
+static int16_t toDegrees(int32_t heading) {
+	int32_t degrees = (heading / HEADING_SCALE) % 360;
+	return (int16_t) (degrees < 0 ? degrees + 360 : degrees);
+}
+
+static int32_t squareRoot(int32_t value) {
+	int32_t root = 0, bit = 1L << 30;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+int8_t motioncompApply(const struct RobotState *state, int32_t bearing, int8_t speed,
+		int32_t *aimHeading) {
+	int16_t sh = trigSin(state->headingWrapped), ch = trigCos(state->headingWrapped);
+	int16_t b = toDegrees(bearing), sb = trigSin(b), cb = trigCos(b);
+	int32_t fieldX, fieldY, along, across, launchAlong, launch, offset;
+
+	*aimHeading = bearing;
+
+	if (speed <= 0) {
+		return speed;
+	}
+
+	// The robot's velocity in the field frame, then split into toward the goal and to its right
+	fieldX = ((int32_t) state->velocityX * ch - (int32_t) state->velocityY * sh) >> TRIG_SHIFT;
+	fieldY = ((int32_t) state->velocityX * sh + (int32_t) state->velocityY * ch) >> TRIG_SHIFT;
+	along = (fieldY * cb - fieldX * sb) >> TRIG_SHIFT;
+	across = (fieldX * cb + fieldY * sb) >> TRIG_SHIFT;
+
+	// The launch must supply whatever the robot's motion doesn't
+	launchAlong = speed * BALL_SPEED_PER_UNIT - along;
+	if (launchAlong <= 0) {
+		return 0;
+	}
+
+	// Turning counterclockwise sends the ball left, against motion to the right
+	offset = across * UNITS_PER_RADIAN / launchAlong;
+	if (offset > MAX_AIM_OFFSET) {
+		offset = MAX_AIM_OFFSET;
+	} else if (offset < -MAX_AIM_OFFSET) {
+		offset = -MAX_AIM_OFFSET;
+	}
+	*aimHeading = bearing + offset;
+
+	launch = squareRoot(launchAlong * launchAlong + across * across);
+	launch = (launch + BALL_SPEED_PER_UNIT / 2) / BALL_SPEED_PER_UNIT;
+
+	return (int8_t) (launch > MAX_SPEED ? MAX_SPEED : launch);
+}
@@ -0,0 +1,110 @@
+#include "mprofile.h"
+
+#include "main.h"
+#include <math.h>
+
+#define DT (MPROFILE_PERIOD / 1000.0f)	// s
+
+struct Trapezoid {
+	float accelTime, cruiseTime, peak, accel;
+};
+
+static void planTrapezoid(struct Trapezoid *t, float distance, float maxVelocity,
+		float maxAccel) {
+	t->accel = maxAccel;
+	t->accelTime = maxVelocity / maxAccel;
+
+	// Too short to reach the maximum velocity, so accelerate for half the distance instead
+	if (maxVelocity * t->accelTime > distance) {
+		t->peak = sqrtf(distance * maxAccel);
+		t->accelTime = t->peak / maxAccel;
+		t->cruiseTime = 0;
+	} else {
+		t->peak = maxVelocity;
+		t->cruiseTime = (distance - maxVelocity * t->accelTime) / maxVelocity;
+	}
+}
+
+static float velocityAt(const struct Trapezoid *t, float time) {
+	if (time < 0) {
+		return 0;
+	} else if (time < t->accelTime) {
+		return t->accel * time;
+	} else if (time < t->accelTime + t->cruiseTime) {
+		return t->peak;
+	}
+
+	time -= t->accelTime + t->cruiseTime;
+	return (time < t->accelTime) ? t->peak - t->accel * time : 0;
+}
+
+/*
+ * Samples the trapezoid at the middle of each cycle, averaged over a window of the given
+ * number of cycles. Averaging a trapezoid over the time its acceleration takes to ramp up
+ * limits the jerk without changing the distance covered.
+ */
+static bool generate(struct MotionProfile *profile, float distance, float maxVelocity,
+		float maxAccel, int16_t window, float topSpeed) {
+	struct Trapezoid t;
+	int16_t i, j, numSamples;
+	float sum, command, sign = (distance < 0) ? -1 : 1;
+
+	profile->length = 0;
+
+	if (distance == 0 || maxVelocity <= 0 || maxAccel <= 0 || topSpeed <= 0) {
+		return distance == 0;
+	}
+
+	planTrapezoid(&t, fabsf(distance), maxVelocity, maxAccel);
+	numSamples = (int16_t) ceilf((2 * t.accelTime + t.cruiseTime) / DT);
+
+	if (numSamples + window - 1 > MPROFILE_LENGTH_LIMIT) {
+		return false;
+	}
+
+	for (i = 0; i < numSamples + window - 1; ++i) {
+		sum = 0;
+		for (j = i - window + 1; j <= i; ++j) {
+			sum += velocityAt(&t, (j + 0.5f) * DT);
+		}
+
+		command = sign * sum / window * MAX_SPEED / topSpeed;
+		if (command > MAX_SPEED) {
+			command = MAX_SPEED;
+		} else if (command < MIN_SPEED) {
+			command = MIN_SPEED;
+		}
+
+		profile->speeds[i] = (int8_t) roundf(command);
+	}
+
+	profile->length = numSamples + window - 1;
+	return true;
+}
+
+bool mprofileInitTrapezoid(struct MotionProfile *profile, float distance, float maxVelocity,
+		float maxAccel, float topSpeed) {
+	return generate(profile, distance, maxVelocity, maxAccel, 1, topSpeed);
+}
+
+bool mprofileInitSCurve(struct MotionProfile *profile, float distance, float maxVelocity,
+		float maxAccel, float maxJerk, float topSpeed) {
+	int16_t window = 1;
+
+	if (maxJerk > 0) {
+		window = (int16_t) roundf(maxAccel / maxJerk / DT);
+		if (window < 1) {
+			window = 1;
+		}
+	}
+
+	return generate(profile, distance, maxVelocity, maxAccel, window, topSpeed);
+}
+
+int8_t mprofileGet(const struct MotionProfile *profile, int16_t tick) {
+	return (tick >= 0 && tick < profile->length) ? profile->speeds[tick] : 0;
+}
+
+bool mprofileIsDone(const struct MotionProfile *profile, int16_t tick) {
+	return tick >= profile->length;
+}
@@ -36,30 +36,160 @@
 
 #include "actions.h"
 #include "togglebtn.h"
+#include "controls.h"
+#include "rcurve.h"
+#include "config.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "autotune.h"
+#include "watchdog.h"
+#include "opcontrol.h"
 #include <stdint.h>
 #include <stdbool.h>
 
-#define JOYSTICK_SLOT 1
+#define SHOOTER_MAX_SPEED MAX_SPEED
+#define SHOOTER_MIN_SPEED 0
 
-#define DRIVE_AXIS 3
-#define STRAFE_AXIS 4
-#define ROTATION_AXIS 1
+unsigned long loopTime = 0;
 
-#define INTAKE_BUTTON_GROUP 7
-#define CONTROL_BUTTON_GROUP 8
-#define LIFTER_BUTTON_GROUP 5
-#define SHOOTER_ADJUST_BUTTON_GROUP 6
+//#define AUTO
+//#define TEST
 
-#define DIAGONAL_DRIVE_DEADBAND 30
+#define DEFAULT_PRESET 0
 
-#define INTAKE_SPEED 127
-#define LIFTER_SPEED 60
+// Operator control state kept from one cycle to the next; see opcontrolReset()
+static int8_t currentPreset;
+static int16_t shooterSpeed;
+static int8_t frontIntakeSpeed;
+static bool isShooterOn;
 
-#define SHOOTER_MAX_SPEED MAX_SPEED
-#define SHOOTER_MIN_SPEED 0
+void opcontrolInit(void) {
+	rcurveInitDeadband(DRIVE_PROFILE_LINEAR, DRIVE_AXIS, config.driveDeadband, MAX_SPEED);
+	rcurveInitDeadband(DRIVE_PROFILE_LINEAR, STRAFE_AXIS, config.driveDeadband, MAX_SPEED);
+	rcurveInitDeadband(DRIVE_PROFILE_LINEAR, ROTATION_AXIS, config.rotationDeadband,
+			config.rotationMaxSpeed);
 
-//#define AUTO
-//#define TEST
+	rcurveInitExpo(DRIVE_PROFILE_PRECISE, DRIVE_AXIS, config.driveDeadband,
+			config.preciseDriveExpo, MAX_SPEED);
+	rcurveInitExpo(DRIVE_PROFILE_PRECISE, STRAFE_AXIS, config.driveDeadband,
+			config.preciseDriveExpo, MAX_SPEED);
+	rcurveInitExpo(DRIVE_PROFILE_PRECISE, ROTATION_AXIS, config.rotationDeadband,
+			config.preciseDriveExpo, config.rotationMaxSpeed);
+
+	rcurveSetProfile(DRIVE_PROFILE_LINEAR);
+}
+
+void opcontrolReset(void) {
+	currentPreset = DEFAULT_PRESET;
+	shooterSpeed = config.shooterSpeedPresets[DEFAULT_PRESET]; //shooter is on when robot starts
+	frontIntakeSpeed = config.intakeSpeed;
+	isShooterOn = true;
+	resetDrive();
+}
+
+void opcontrolStep(void) {
+	unsigned long loopStart = micros();
+	int8_t xSpeed, ySpeed, rotation;
+	int8_t lifterSpeed/*, intakeSpeed*/;
+
+	PROFILE_BEGIN(PROFILE_LOOP);
+
+	PROFILE_BEGIN(PROFILE_INPUT);
+	controlsUpdate();
+
+	// drive profile
+	if (controlsGetButton(CONTROLS_DRIVE, CONTROL_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
+		rcurveSetProfile((rcurveGetProfile() + 1) % NUM_DRIVE_PROFILES);
+	}
+
+	// drive
+	xSpeed = rcurveApply(STRAFE_AXIS, controlsGetAxis(CONTROLS_DRIVE, STRAFE_AXIS));
+	ySpeed = rcurveApply(DRIVE_AXIS, controlsGetAxis(CONTROLS_DRIVE, DRIVE_AXIS));
+	rotation = rcurveApply(ROTATION_AXIS, controlsGetAxis(CONTROLS_DRIVE, ROTATION_AXIS));
+
+	// auto-aim; turns to face the goal while held, leaving translation to the driver
+	setAim(controlsIsDown(CONTROLS_DRIVE, CONTROL_BUTTON_GROUP, JOY_LEFT));
+	PROFILE_END(PROFILE_INPUT);
+
+	PROFILE_BEGIN(PROFILE_DRIVE);
+	drive(xSpeed, ySpeed, rotation, false);
+	PROFILE_END(PROFILE_DRIVE);
+
+	// lifter up down
+	PROFILE_BEGIN(PROFILE_LIFTER);
+	if (controlsIsDown(CONTROLS_LIFTER, LIFTER_BUTTON_GROUP, JOY_UP)) {
+		lifterSpeed = config.lifterSpeed;
+	} else if (controlsIsDown(CONTROLS_LIFTER, LIFTER_BUTTON_GROUP, JOY_DOWN)) {
+		lifterSpeed = -config.lifterSpeed;
+	} else {
+		lifterSpeed = 0;
+	}
+
+	lifter(lifterSpeed);
+	takeInInternal(lifterSpeed);
+	PROFILE_END(PROFILE_LIFTER);
+
+	PROFILE_BEGIN(PROFILE_SHOOTER);
+	if (isShooterOn) {
+		// shooter increase speed
+		if (controlsGetButton(CONTROLS_SHOOTER, SHOOTER_ADJUST_BUTTON_GROUP, JOY_UP)
+				== BUTTON_PRESSED) {
+			++currentPreset;
+
+			if (currentPreset >= NUM_SHOOTER_SPEED_PRESETS) {
+				currentPreset = NUM_SHOOTER_SPEED_PRESETS - 1;
+			}
+		}
+
+		// shooter decrease speed
+		if (controlsGetButton(CONTROLS_SHOOTER, SHOOTER_ADJUST_BUTTON_GROUP, JOY_DOWN)
+				== BUTTON_PRESSED) {
+			--currentPreset;
+
+			if (currentPreset < 0) {
+				currentPreset = 0;
+			}
+		}
+
+		shooterSpeed = config.shooterSpeedPresets[currentPreset];
+	}
+
+	// shooter on off
+	if (controlsGetButton(CONTROLS_SHOOTER, CONTROL_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
+		isShooterOn = !isShooterOn;
+		shooterSpeed = isShooterOn ? config.shooterSpeedPresets[DEFAULT_PRESET] : 0;
+	}
+
+	// shooter tuning; both intake off buttons held together
+	if (controlsIsDown(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_LEFT)
+		&& controlsIsDown(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_RIGHT)) {
+		autotuneStart();
+	}
+
+	shooter(shooterSpeed);
+	PROFILE_END(PROFILE_SHOOTER);
+
+	// intake mode
+	PROFILE_BEGIN(PROFILE_INTAKE);
+	if (controlsGetButton(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_LEFT) == BUTTON_PRESSED
+		|| controlsGetButton(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_RIGHT) == BUTTON_PRESSED) {
+		frontIntakeSpeed = 0;
+	} else if (controlsGetButton(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
+		frontIntakeSpeed = -config.intakeSpeed;
+	} else if (controlsGetButton(CONTROLS_INTAKE, INTAKE_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
+		frontIntakeSpeed = config.intakeSpeed;
+	}
+
+	takeInFront(frontIntakeSpeed);
+	PROFILE_END(PROFILE_INTAKE);
+
+	PROFILE_BEGIN(PROFILE_TELEMETRY);
+	telemetrySendTick();
+	PROFILE_END(PROFILE_TELEMETRY);
+
+	loopTime = micros() - loopStart;
+	PROFILE_END(PROFILE_LOOP);
+}
 
 /*
  * Runs the user operator control code. This function will be started in its own task with the
@@ -90,7 +220,7 @@ void operatorControl() {
 	int8_t lifterSpeed/*, intakeSpeed*/;
 
 	int16_t shooterSpeed = DEFAULT_SHOOTER_SPEED; //shooter is on when robot starts
-	int8_t frontIntakeSpeed = INTAKE_SPEED;
+	int8_t frontIntakeSpeed = config.intakeSpeed;
 	bool isShooterOn = true;
 	bool isAutoShootOn = false;
 
@@ -104,32 +234,28 @@ void operatorControl() {
 	toggleBtnInit(JOYSTICK_SLOT, CONTROL_BUTTON_GROUP, JOY_RIGHT);   // auto shoot on off
 	toggleBtnInit(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_UP);   // shooter speed up
 	toggleBtnInit(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_DOWN);   // shooter speed down
+	toggleBtnInit(JOYSTICK_SLOT, CONTROL_BUTTON_GROUP, JOY_UP);   // drive profile
 
 	while (true) {
-		printf("ultra distance (in): %f\r\n", ultrasonicGet(ultra) / 2.54);
-
 		toggleBtnUpdateAll();
 
-		// drive
-		xSpeed = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, STRAFE_AXIS);
-		ySpeed = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, DRIVE_AXIS);
-		rotation = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, ROTATION_AXIS) / 2;
-
-		if (abs(ySpeed) < DIAGONAL_DRIVE_DEADBAND) {
-			ySpeed = 0;
+		// drive profile
+		if (toggleBtnGet(JOYSTICK_SLOT, CONTROL_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
+			rcurveSetProfile((rcurveGetProfile() + 1) % NUM_DRIVE_PROFILES);
 		}
 
-		if (abs(xSpeed) < DIAGONAL_DRIVE_DEADBAND) {
-			xSpeed = 0;
-		}
+		// drive
+		xSpeed = rcurveApply(STRAFE_AXIS, joystickGetAnalog(JOYSTICK_SLOT, STRAFE_AXIS));
+		ySpeed = rcurveApply(DRIVE_AXIS, joystickGetAnalog(JOYSTICK_SLOT, DRIVE_AXIS));
+		rotation = rcurveApply(ROTATION_AXIS, joystickGetAnalog(JOYSTICK_SLOT, ROTATION_AXIS));
 
 		drive(xSpeed, ySpeed, rotation, false);
 
 		// lifter up down
 		if (joystickGetDigital(JOYSTICK_SLOT, LIFTER_BUTTON_GROUP, JOY_UP)) {
-			lifterSpeed = LIFTER_SPEED;
+			lifterSpeed = config.lifterSpeed;
 		} else if (joystickGetDigital(JOYSTICK_SLOT, LIFTER_BUTTON_GROUP, JOY_DOWN)) {
-			lifterSpeed = -LIFTER_SPEED;
+			lifterSpeed = -config.lifterSpeed;
 		} else {
 			lifterSpeed = 0;
 		}
@@ -179,109 +305,24 @@ void operatorControl() {
 			|| toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_RIGHT) == BUTTON_PRESSED) {
 			frontIntakeSpeed = 0;
 		} else if (toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
-			frontIntakeSpeed = -INTAKE_SPEED;
+			frontIntakeSpeed = -config.intakeSpeed;
 		} else if (toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
-			frontIntakeSpeed = INTAKE_SPEED;
+			frontIntakeSpeed = config.intakeSpeed;
 		}
 
 		takeInFront(frontIntakeSpeed);
 
+		watchdogFeed(WATCHDOG_CONTROL);
 		delay(20);
 	}
 #else
-	int8_t xSpeed, ySpeed, rotation;
-	int8_t lifterSpeed/*, intakeSpeed*/;
-	int8_t defaultPreset = 0;
-	int8_t currentPreset = defaultPreset;
-
-	int16_t shooterSpeed = shooterSpeedPresets[defaultPreset]; //shooter is on when robot starts
-	int8_t frontIntakeSpeed = INTAKE_SPEED;
-	bool isShooterOn = true;
-
 	//lfilterClear();
-
-	toggleBtnInit(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_UP);		// intake forward
-	toggleBtnInit(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_LEFT);	// intake off
-	toggleBtnInit(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_RIGHT);	// intake off
-	toggleBtnInit(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_DOWN);	// intake backward
-	toggleBtnInit(JOYSTICK_SLOT, CONTROL_BUTTON_GROUP, JOY_DOWN);   // shooter on off
-	toggleBtnInit(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_UP);   // shooter speed up
-	toggleBtnInit(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_DOWN);   // shooter speed down
+	opcontrolReset();
 
 	while (true) {
-		printf("ultra distance (in): %f\r\n", ultrasonicGet(ultra) / 2.54);
-
-		toggleBtnUpdateAll();
-
-		// drive
-		xSpeed = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, STRAFE_AXIS);
-		ySpeed = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, DRIVE_AXIS);
-		rotation = (int8_t) joystickGetAnalog(JOYSTICK_SLOT, ROTATION_AXIS) / 2;
-
-		if (abs(ySpeed) < DIAGONAL_DRIVE_DEADBAND) {
-			ySpeed = 0;
-		}
-
-		if (abs(xSpeed) < DIAGONAL_DRIVE_DEADBAND) {
-			xSpeed = 0;
-		}
-
-		drive(xSpeed, ySpeed, rotation, false);
-
-		// lifter up down
-		if (joystickGetDigital(JOYSTICK_SLOT, LIFTER_BUTTON_GROUP, JOY_UP)) {
-			lifterSpeed = LIFTER_SPEED;
-		} else if (joystickGetDigital(JOYSTICK_SLOT, LIFTER_BUTTON_GROUP, JOY_DOWN)) {
-			lifterSpeed = -LIFTER_SPEED;
-		} else {
-			lifterSpeed = 0;
-		}
-
-		lifter(lifterSpeed);
-		takeInInternal(lifterSpeed);
-
-		if (isShooterOn) {
-			// shooter increase speed
-			if (toggleBtnGet(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
-				++currentPreset;
-
-				if (currentPreset >= NUM_SHOOTER_SPEED_PRESETS) {
-					currentPreset = NUM_SHOOTER_SPEED_PRESETS - 1;
-				}
-			}
-
-			// shooter decrease speed
-			if (toggleBtnGet(JOYSTICK_SLOT, SHOOTER_ADJUST_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
-				--currentPreset;
-
-				if (currentPreset < 0) {
-					currentPreset = 0;
-				}
-			}
-
-			shooterSpeed = shooterSpeedPresets[currentPreset];
-		}
-
-		// shooter on off
-		if (toggleBtnGet(JOYSTICK_SLOT, CONTROL_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
-			isShooterOn = !isShooterOn;
-			shooterSpeed = isShooterOn ? shooterSpeedPresets[defaultPreset] : 0;
-		}
-
-		shooter(shooterSpeed);
-
-		// intake mode
-		if (toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_LEFT) == BUTTON_PRESSED
-			|| toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_RIGHT) == BUTTON_PRESSED) {
-			frontIntakeSpeed = 0;
-		} else if (toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_UP) == BUTTON_PRESSED) {
-			frontIntakeSpeed = -INTAKE_SPEED;
-		} else if (toggleBtnGet(JOYSTICK_SLOT, INTAKE_BUTTON_GROUP, JOY_DOWN) == BUTTON_PRESSED) {
-			frontIntakeSpeed = INTAKE_SPEED;
-		}
-
-		takeInFront(frontIntakeSpeed);
+		opcontrolStep();
 
+		watchdogFeed(WATCHDOG_CONTROL);
 		delay(20);
 	}
 #endif
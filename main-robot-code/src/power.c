@@ -0,0 +1,129 @@
+#include "power.h"
+
+#include "main.h"
+#include "config.h"
+#include "robotstate.h"
+
+#define NUM_CHANNELS 10
+
+// 393 motor model: current rises with the command and falls as back EMF builds with speed
+#define STALL_CURRENT 4800	// mA at full command, 7.2 V
+#define FREE_VELOCITY 3920	// IME units at full command with no load; 160 rpm
+
+#define CUT_SHIFT 8
+
+#define MECHANISM_PRIORITY(mechanism, field, filterChannel, priority) priority,
+
+static const int8_t priorities[NUM_MECHANISMS] = { MECHANISM_TABLE(MECHANISM_PRIORITY) };
+
+static volatile int16_t requests[NUM_CHANNELS] = { 0 };
+static volatile int16_t cuts[NUM_MECHANISMS] = { 0 };	// command removed, in 1/2^CUT_SHIFT
+static volatile int32_t demand = 0;
+static volatile unsigned long lastUpdate = 0;
+static Mutex mutex = NULL;	// held by whichever task is updating the cuts
+
+// Only the drive wheels and the flywheel have IMEs; everything else is assumed to be stalled
+static int16_t getVelocity(unsigned char channel, const struct RobotState *state) {
+	switch (channel) {
+	case FRONT_LEFT_MOTOR_CHANNEL: return state->wheelVelocities[0];
+	case BACK_LEFT_MOTOR_CHANNEL: return state->wheelVelocities[1];
+	case FRONT_RIGHT_MOTOR_CHANNEL: return state->wheelVelocities[2];
+	case BACK_RIGHT_MOTOR_CHANNEL: return state->wheelVelocities[3];
+	case SHOOTER_MOTOR_CHANNEL:
+	case SHOOTER_MOTOR_CHANNEL2: return state->shooterVelocity;
+	default: return 0;
+	}
+}
+
+static int32_t estimateCurrent(unsigned char channel, int16_t speed,
+		const struct RobotState *state) {
+	int32_t effective;
+
+	if (speed == 0) {
+		return 0;
+	}
+
+	effective = speed - (int32_t) getVelocity(channel, state) * MAX_SPEED / FREE_VELOCITY;
+	return (int32_t) STALL_CURRENT * abs(effective) / MAX_SPEED;
+}
+
+// Serves the priorities in order from the current left over, cutting whatever doesn't fit
+static void update(void) {
+	int32_t currents[NUM_MECHANISMS] = { 0 };
+	int32_t remaining = (int32_t) config.currentBudget * 1000, total = 0, wanted;
+	int32_t available;
+	int8_t priority, maxPriority = 0, mechanism, i;
+	struct RobotState state;
+
+	robotstateGet(&state);
+
+	for (i = 0; i < NUM_CHANNELS; ++i) {
+		mechanism = mechanismsGetMechanism(i + 1);
+		if (mechanism >= 0) {
+			currents[mechanism] += estimateCurrent(i + 1, requests[i], &state);
+		}
+	}
+
+	for (i = 0; i < NUM_MECHANISMS; ++i) {
+		total += currents[i];
+		if (priorities[i] > maxPriority) {
+			maxPriority = priorities[i];
+		}
+	}
+
+	for (priority = 0; priority <= maxPriority; ++priority) {
+		wanted = 0;
+		for (i = 0; i < NUM_MECHANISMS; ++i) {
+			if (priorities[i] == priority) {
+				wanted += currents[i];
+			}
+		}
+
+		available = (remaining > 0) ? remaining : 0;
+		for (i = 0; i < NUM_MECHANISMS; ++i) {
+			if (priorities[i] != priority) {
+				continue;
+			}
+
+			if (priority == 0 || wanted <= available) {
+				cuts[i] = 0;
+			} else {
+				cuts[i] = ((wanted - available) << CUT_SHIFT) / wanted;
+			}
+		}
+
+		remaining -= wanted;
+	}
+
+	demand = total;
+}
+
+void powerInit(void) {
+	mutex = mutexCreate();
+}
+
+int16_t powerApply(unsigned char channel, int16_t speed) {
+	int8_t mechanism = mechanismsGetMechanism(channel);
+
+	if (mechanism < 0) {
+		return speed;
+	}
+
+	requests[channel - 1] = speed;
+
+	// Both the operator control and wheel control tasks get here; whichever finds the cuts stale
+	// updates them, and the other keeps using the ones it has rather than waiting
+	if (millis() - lastUpdate >= POWER_PERIOD && mutexTake(mutex, 0)) {
+		if (millis() - lastUpdate >= POWER_PERIOD) {
+			lastUpdate = millis();
+			update();
+		}
+		mutexGive(mutex);
+	}
+
+	return (int32_t) speed * ((1 << CUT_SHIFT) - cuts[mechanism]) / (1 << CUT_SHIFT);
+}
+
+int32_t powerGetDemand(void) {
+	return demand;
+}
@@ -0,0 +1,79 @@
+#include "profiler.h"
+
+#ifdef PROFILER
+
+#include "main.h"
+#include "histogram.h"
+#include "memdiag.h"
+#include "latency.h"
+
+#define PROFILER_PERIOD 100	// ms between checks for commands
+#define BUCKET_SHIFT 5	// 32 us buckets, so stages up to about 1 ms are resolved
+
+unsigned long profilerStarts[NUM_PROFILE_STAGES];
+
+static struct Histogram histograms[NUM_PROFILE_STAGES];
+
+static const char *stageNames[NUM_PROFILE_STAGES] = {
+	"loop", "input", "drive", "lifter", "shooter", "intake", "telemetry"
+};
+
+static void clear(void) {
+	int8_t i;
+
+	for (i = 0; i < NUM_PROFILE_STAGES; ++i) {
+		histogramInit(&histograms[i], BUCKET_SHIFT);
+	}
+
+	latencyClear();
+}
+
+static void dump(void) {
+	const struct Histogram *h;
+	int8_t i;
+
+	printf("stage       count      min      max      p50      p99\r\n");
+
+	for (i = 0; i < NUM_PROFILE_STAGES; ++i) {
+		h = &histograms[i];
+		printf("%-10s %6lu %8lu %8lu %8lu %8lu\r\n", stageNames[i], (unsigned long) h->total,
+				(unsigned long) (h->total > 0 ? h->min : 0), (unsigned long) h->max,
+				(unsigned long) histogramPercentile(h, 50),
+				(unsigned long) histogramPercentile(h, 99));
+	}
+}
+
+static void profilerTask(void *ignore) {
+	while (true) {
+		while (fcount(stdin) > 0) {
+			switch (fgetc(stdin)) {
+			case 'p':
+				dump();
+				break;
+			case 'r':
+				clear();
+				break;
+			case 'm':
+				memdiagPrint();
+				break;
+			case 'l':
+				latencyPrint();
+				break;
+			}
+		}
+
+		delay(PROFILER_PERIOD);
+	}
+}
+
+void profilerInit(void) {
+	clear();
+	memdiagTaskCreate("profiler", profilerTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_LOWEST);
+}
+
+void profilerRecord(enum ProfileStage stage, unsigned long elapsed) {
+	histogramAdd(&histograms[stage], elapsed);
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "rangefilter.h"
+
+#include "robotstate.h"
+
+#define CM_TO_RANGE(cm) ((int32_t) (cm) * ODOMETRY_SCALE * 100 / 254)
+
+// Variances in (1/ODOMETRY_SCALE in)^2
+#define PING_VARIANCE 256	// about 1 in of noise
+#define MOVE_VARIANCE 16	// per prediction; odometry drifts about 1/4 in every 10 ms
+#define TURN_VARIANCE 2	// per prediction per degree per second of turning
+#define MAX_VARIANCE (48L * 48 * ODOMETRY_SCALE * ODOMETRY_SCALE)
+
+#define GATE_SIGMAS 3	// pings further than this from the prediction are rejected
+#define REJECT_LIMIT 10	// rejections in a row before the filter starts over
+#define STALE_LIMIT 5	// calls before an unchanged ping is used again
+
+#define GAIN_SHIFT 15
+
+static void reset(struct RangeFilter *filter, int16_t ping) {
+	filter->range = CM_TO_RANGE(ping) * 1000;
+	filter->variance = PING_VARIANCE;
+	filter->rejects = 0;
+	filter->isValid = true;
+}
+
+void rangefilterInit(struct RangeFilter *filter) {
+	filter->range = 0;
+	filter->variance = MAX_VARIANCE;
+	filter->lastPing = 0;
+	filter->staleCycles = 0;
+	filter->rejects = 0;
+	filter->isValid = false;
+}
+
+void rangefilterPredict(struct RangeFilter *filter, int16_t velocity, int16_t turnRate,
+		int16_t elapsed) {
+	if (!filter->isValid) {
+		return;
+	}
+
+	// Driving forward closes the range
+	filter->range -= (int32_t) velocity * elapsed;
+	if (filter->range < 0) {
+		filter->range = 0;
+	}
+
+	filter->variance += MOVE_VARIANCE + TURN_VARIANCE * (turnRate < 0 ? -turnRate : turnRate);
+	if (filter->variance > MAX_VARIANCE) {
+		filter->variance = MAX_VARIANCE;
+	}
+}
+
+bool rangefilterUpdate(struct RangeFilter *filter, int16_t ping) {
+	int32_t innovation, total, gain;
+
+	if (ping <= 0) {
+		return false;
+	}
+
+	if (ping == filter->lastPing && ++filter->staleCycles < STALE_LIMIT) {
+		return false;
+	}
+	filter->lastPing = ping;
+	filter->staleCycles = 0;
+
+	if (!filter->isValid) {
+		reset(filter, ping);
+		return true;
+	}
+
+	innovation = CM_TO_RANGE(ping) - filter->range / 1000;
+	total = filter->variance + PING_VARIANCE;
+
+	// Compares squares, so no square root is needed for the number of standard deviations
+	if ((int64_t) innovation * innovation > (int64_t) GATE_SIGMAS * GATE_SIGMAS * total) {
+		if (++filter->rejects >= REJECT_LIMIT) {
+			reset(filter, ping);
+			return true;
+		}
+		return false;
+	}
+
+	filter->rejects = 0;
+	gain = ((int64_t) filter->variance << GAIN_SHIFT) / total;
+	filter->range += (int32_t) (((int64_t) innovation * gain * 1000) >> GAIN_SHIFT);
+	filter->variance -= ((int64_t) filter->variance * gain) >> GAIN_SHIFT;
+
+	return true;
+}
+
+int16_t rangefilterGet(const struct RangeFilter *filter) {
+	return filter->isValid ? (int16_t) (filter->range / 1000) : 0;
+}
@@ -0,0 +1,102 @@
+#include "rcurve.h"
+
+#include "main.h"
+
+#define TABLE_SIZE 256
+
+static int8_t tables[RCURVE_PROFILE_LIMIT][RCURVE_AXIS_LIMIT][TABLE_SIZE] = { { { 0 } } };
+static int8_t (*curves)[TABLE_SIZE] = tables[0];
+static int8_t profileInUse = 0;
+
+static bool isValid(int8_t profile, int8_t axis) {
+	return profile >= 0 && profile < RCURVE_PROFILE_LIMIT && axis > 0 && axis <= RCURVE_AXIS_LIMIT;
+}
+
+// Every signed input is reinterpreted as an unsigned table index, so -1 is stored at 255
+static void fillTable(int8_t *table, int8_t deadband, float expo, int8_t maxOutput) {
+	int16_t i, in;
+	float x, out;
+
+	if (deadband < 0) {
+		deadband = 0;
+	} else if (deadband >= MAX_SPEED) {
+		deadband = MAX_SPEED - 1;
+	}
+
+	for (i = 0; i < TABLE_SIZE; ++i) {
+		in = abs((int8_t) i);
+		if (in > MAX_SPEED) {
+			in = MAX_SPEED;
+		}
+
+		if (in <= deadband) {
+			out = 0;
+		} else {
+			x = (float) (in - deadband) / (MAX_SPEED - deadband);
+			out = ((1 - expo) * x + expo * x * x * x) * maxOutput + 0.5f;
+		}
+
+		table[i] = ((int8_t) i < 0) ? -(int8_t) out : (int8_t) out;
+	}
+}
+
+void rcurveInitDeadband(int8_t profile, int8_t axis, int8_t deadband, int8_t maxOutput) {
+	if (isValid(profile, axis)) {
+		fillTable(tables[profile][axis - 1], deadband, 0, maxOutput);
+	}
+}
+
+void rcurveInitExpo(int8_t profile, int8_t axis, int8_t deadband, int8_t expo, int8_t maxOutput) {
+	if (expo > 100) {
+		expo = 100;
+	} else if (expo < 0) {
+		expo = 0;
+	}
+
+	if (isValid(profile, axis)) {
+		fillTable(tables[profile][axis - 1], deadband, expo / 100.0f, maxOutput);
+	}
+}
+
+void rcurveInitCustom(int8_t profile, int8_t axis, const int8_t *points, int8_t numPoints) {
+	int8_t *table;
+	int16_t i, in, seg, span, out;
+
+	if (isValid(profile, axis) && numPoints >= 2) {
+		table = tables[profile][axis - 1];
+		span = numPoints - 1;
+
+		for (i = 0; i < TABLE_SIZE; ++i) {
+			in = abs((int8_t) i);
+			if (in > MAX_SPEED) {
+				in = MAX_SPEED;
+			}
+
+			// Find the segment containing the input, then interpolate between its end points
+			seg = in * span / MAX_SPEED;
+			if (seg >= span) {
+				out = points[span];
+			} else {
+				out = points[seg] + (points[seg + 1] - points[seg])
+						* (in * span - seg * MAX_SPEED) / MAX_SPEED;
+			}
+
+			table[i] = ((int8_t) i < 0) ? -out : out;
+		}
+	}
+}
+
+void rcurveSetProfile(int8_t profile) {
+	if (profile >= 0 && profile < RCURVE_PROFILE_LIMIT) {
+		profileInUse = profile;
+		curves = tables[profile];
+	}
+}
+
+int8_t rcurveGetProfile(void) {
+	return profileInUse;
+}
+
+int8_t rcurveApply(int8_t axis, int8_t value) {
+	return (axis > 0 && axis <= RCURVE_AXIS_LIMIT) ? curves[axis - 1][(uint8_t) value] : 0;
+}
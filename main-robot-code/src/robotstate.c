@@ -0,0 +1,28 @@
+#include "robotstate.h"
+
+/*
+ * The publisher fills the buffer readers aren't directed to, then advances the sequence number
+ * to switch them over. A reader that sees the sequence number change while copying may have
+ * been overtaken by a second publish into its buffer, so it tries again.
+ */
+static struct RobotState buffers[2];
+static volatile uint32_t sequence = 0;	// the latest snapshot is in buffers[sequence & 1]
+
+void robotstatePublish(const struct RobotState *state) {
+	uint32_t next = sequence + 1;
+
+	buffers[next & 1] = *state;
+	__sync_synchronize();	// the snapshot must be complete before readers are switched to it
+	sequence = next;
+}
+
+void robotstateGet(struct RobotState *state) {
+	uint32_t start;
+
+	do {
+		start = sequence;
+		__sync_synchronize();
+		*state = buffers[start & 1];
+		__sync_synchronize();
+	} while (start != sequence);
+}
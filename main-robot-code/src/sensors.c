@@ -0,0 +1,95 @@
+#include "sensors.h"
+
+#include "main.h"
+#include "heading.h"
+#include "memdiag.h"
+#include "robotstate.h"
+#include "watchdog.h"
+#include "trig.h"
+#include "rangefilter.h"
+
+#define SENSORS_PERIOD 10	// ms, the same as the heading task
+
+/*
+ * Wheel surface speed per IME velocity unit for 4 in wheels on high speed 393 motors (24.5 units
+ * per rpm), times the sqrt(2) / 4 that turns the four wheel speeds of the X-drive into the
+ * robot's velocity. Scaled by 2^16 and including ODOMETRY_SCALE.
+ */
+#define IME_TO_VELOCITY 3169
+#define IME_TO_VELOCITY_SHIFT 16
+
+// Front left, back left, front right, back right; the last reading is kept if an IME doesn't answer
+static int16_t wheels[4];
+static int32_t xSum = 0, ySum = 0;	// position in 1/ODOMETRY_SCALE in per 1000
+static struct RangeFilter rangeFilter;
+
+static void readWheels(void) {
+	static const unsigned char addresses[4] = { FRONT_LEFT_IME_ADDRESS, BACK_LEFT_IME_ADDRESS,
+			FRONT_RIGHT_IME_ADDRESS, BACK_RIGHT_IME_ADDRESS };
+	int velocity;
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		if (imeGetVelocity(addresses[i], &velocity)) {
+			wheels[i] = velocity;
+		}
+	}
+}
+
+// Inverts the mixing in drive(), then integrates the velocity in the field frame
+static void updateOdometry(struct RobotState *state) {
+	int32_t x = wheels[0] - wheels[1] + wheels[2] - wheels[3];
+	int32_t y = wheels[0] + wheels[1] - wheels[2] - wheels[3];
+	int16_t s = trigSin(state->headingWrapped), c = trigCos(state->headingWrapped);
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		state->wheelVelocities[i] = wheels[i];
+	}
+
+	state->velocityX = (x * IME_TO_VELOCITY) >> IME_TO_VELOCITY_SHIFT;
+	state->velocityY = (y * IME_TO_VELOCITY) >> IME_TO_VELOCITY_SHIFT;
+
+	xSum += (((int32_t) state->velocityX * c - (int32_t) state->velocityY * s) >> TRIG_SHIFT)
+			* SENSORS_PERIOD;
+	ySum += (((int32_t) state->velocityX * s + (int32_t) state->velocityY * c) >> TRIG_SHIFT)
+			* SENSORS_PERIOD;
+
+	state->x = xSum / 1000;
+	state->y = ySum / 1000;
+}
+
+static void sensorsTask(void *ignore) {
+	unsigned long wakeTime = millis();
+	struct RobotState state;
+	int velocity = 0;
+
+	while (true) {
+		state.time = millis();
+		state.heading = headingGet();
+		state.headingWrapped = headingGetWrapped();
+		state.turnRate = headingGetRate();
+		state.distance = ultrasonicGet(ultra);
+
+		// The last good reading is kept if the IME doesn't answer
+		imeGetVelocity(SHOOTER_IME_ADDRESS, &velocity);
+		state.shooterVelocity = velocity;
+
+		readWheels();
+		updateOdometry(&state);
+
+		rangefilterPredict(&rangeFilter, state.velocityY, state.turnRate, SENSORS_PERIOD);
+		rangefilterUpdate(&rangeFilter, state.distance);
+		state.range = rangefilterGet(&rangeFilter);
+
+		robotstatePublish(&state);
+		watchdogFeed(WATCHDOG_SENSORS);
+		taskDelayUntil(&wakeTime, SENSORS_PERIOD);
+	}
+}
+
+void sensorsInit(void) {
+	rangefilterInit(&rangeFilter);
+	memdiagTaskCreate("sensors", sensorsTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_DEFAULT + 1);
+}
@@ -0,0 +1,159 @@
+#include "telemetry.h"
+
+#include "main.h"
+#include "crc.h"
+#include "robotstate.h"
+#include "controls.h"
+#include "memdiag.h"
+
+#define TELEMETRY_PERIOD 5	// ms between drains of the buffer
+
+#define BUFFER_SIZE 512	// must be a power of 2
+#define MAX_RECORD_LENGTH 64
+#define MAX_FRAME_LENGTH (MAX_RECORD_LENGTH + 2 + MAX_RECORD_LENGTH / 254 + 2)
+
+static FILE *uart = NULL;
+
+// Written only by the sending task (head) and the telemetry task (tail)
+static uint8_t buffer[BUFFER_SIZE];
+static volatile uint16_t head = 0, tail = 0;
+static volatile uint32_t dropped = 0;
+
+// Replaces every zero byte with the distance to the next one, so zero only marks frame ends
+static uint8_t encode(const uint8_t *in, uint8_t length, uint8_t *out) {
+	uint8_t *start = out, *code = out++;
+	uint8_t n = 1, i;
+
+	for (i = 0; i < length; ++i) {
+		if (in[i] == 0) {
+			*code = n;
+			code = out++;
+			n = 1;
+		} else {
+			*out++ = in[i];
+			if (++n == 0xFF) {
+				*code = n;
+				code = out++;
+				n = 1;
+			}
+		}
+	}
+
+	*code = n;
+	*out++ = 0;
+
+	return out - start;
+}
+
+static void telemetryTask(void *ignore) {
+	uint16_t start, end;
+
+	while (true) {
+		start = tail;
+		end = head;
+
+		// Send up to the end of the buffer first, then wrap around on the next pass
+		if (start != end) {
+			if (end < start) {
+				end = BUFFER_SIZE;
+			}
+
+			fwrite(buffer + start, 1, end - start, uart);
+			tail = end & (BUFFER_SIZE - 1);
+		} else {
+			delay(TELEMETRY_PERIOD);
+		}
+	}
+}
+
+void telemetryInit(FILE *port) {
+	if (uart == NULL) {
+		uart = port;
+		memdiagTaskCreate("telemetry", telemetryTask, TASK_DEFAULT_STACK_SIZE, NULL,
+				TASK_PRIORITY_LOWEST + 1);
+	}
+}
+
+void telemetrySend(const void *record, uint8_t length) {
+	uint8_t raw[MAX_RECORD_LENGTH + 2];
+	uint8_t frame[MAX_FRAME_LENGTH];
+	uint16_t crc, space, i, h;
+	uint8_t frameLength;
+
+	if (uart == NULL || length > MAX_RECORD_LENGTH) {
+		return;
+	}
+
+	for (i = 0; i < length; ++i) {
+		raw[i] = ((const uint8_t *) record)[i];
+	}
+
+	crc = crc16(record, length);
+	raw[length] = crc & 0xFF;
+	raw[length + 1] = crc >> 8;
+
+	frameLength = encode(raw, length + 2, frame);
+
+	// One byte is always left free so that a full buffer can be told apart from an empty one
+	h = head;
+	space = (tail - h - 1) & (BUFFER_SIZE - 1);
+	if (frameLength > space) {
+		++dropped;
+		return;
+	}
+
+	for (i = 0; i < frameLength; ++i) {
+		buffer[h] = frame[i];
+		h = (h + 1) & (BUFFER_SIZE - 1);
+	}
+
+	head = h;
+}
+
+void telemetrySendTick(void) {
+	struct TelemetryTick tick;
+	struct RobotState state;
+	uint16_t buttons;
+	int8_t i;
+
+	robotstateGet(&state);
+
+	tick.header.type = TELEMETRY_TICK;
+	tick.header.version = TELEMETRY_SCHEMA_VERSION;
+	tick.time = millis();
+	tick.loopTime = loopTime > UINT16_MAX ? UINT16_MAX : loopTime;
+
+	// Taken from the controls snapshot rather than the joysticks, which may have changed since
+	tick.connected = 0;
+	for (i = 0; i < TELEMETRY_NUM_JOYSTICKS; ++i) {
+		if (controlsGetSnapshot(i + 1, tick.joysticks[i].axes, &buttons)) {
+			tick.connected |= 1 << i;
+		}
+		tick.joysticks[i].buttons = buttons;
+	}
+
+	tick.partnerRoles = 0;
+	for (i = 0; i < CONTROLS_ROLE_LIMIT; ++i) {
+		if (controlsGetSlot((enum ControlsRole) i) == PARTNER_JOYSTICK_SLOT) {
+			tick.partnerRoles |= 1 << i;
+		}
+	}
+
+	for (i = 0; i < TELEMETRY_NUM_MOTORS; ++i) {
+		tick.motors[i] = motorGet(i + 1);
+	}
+
+	tick.heading = state.heading;
+	tick.distance = state.distance;
+	tick.turnRate = state.turnRate;
+	tick.shooterVelocity = state.shooterVelocity;
+	for (i = 0; i < TELEMETRY_NUM_WHEELS; ++i) {
+		tick.wheelVelocities[i] = state.wheelVelocities[i];
+	}
+
+	telemetrySend(&tick, sizeof(tick));
+}
+
+uint32_t telemetryGetDropped(void) {
+	return dropped;
+}
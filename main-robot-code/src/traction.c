@@ -0,0 +1,63 @@
+#include "traction.h"
+
+#include <stdlib.h>
+
+/*
+ * Wheel IME velocity per degree per second of turning, scaled by 16: the wheels sit 9.5 in from
+ * the center, square to it, on 4 in wheels and high speed 393 motors (24.5 units per rpm).
+ */
+#define IME_PER_TURN_RATE 309
+#define IME_PER_TURN_RATE_SHIFT 4
+
+#define SLIP_PERCENT 25	// faster than the partner wheel by this much is slipping
+#define SLIP_FLOOR 150	// IME units; below this the difference is just noise
+#define MIN_PERCENT 40	// the most a command is ever cut to
+#define RECOVERY_PERCENT 5	// released per cycle once the wheel grips
+
+// Each wheel's diagonal partner: front left and back right, back left and front right
+static const int8_t partners[4] = { 3, 2, 1, 0 };
+
+static int8_t percents[4] = { 100, 100, 100, 100 };	// let through to each wheel
+
+void tractionApply(const struct RobotState *state, int16_t speed[4]) {
+	// Opposite in sign to the turn rate, like every rotation command (see heading.h)
+	int32_t rotation = -((int32_t) state->turnRate * IME_PER_TURN_RATE) >> IME_PER_TURN_RATE_SHIFT;
+	int32_t own, partner, limit, target;
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		// Without the rotation, partners turn at the same speed in opposite directions
+		own = abs(state->wheelVelocities[i] - rotation);
+		partner = abs(state->wheelVelocities[partners[i]] - rotation);
+		limit = partner + partner * SLIP_PERCENT / 100 + SLIP_FLOOR;
+
+		// Cut in proportion to how much faster the wheel turns than it should
+		target = (own > limit) ? partner * 100 / own : 100;
+		if (target < MIN_PERCENT) {
+			target = MIN_PERCENT;
+		}
+
+		if (target < percents[i]) {
+			percents[i] = (int8_t) target;
+		} else if (percents[i] < 100) {
+			percents[i] = (percents[i] + RECOVERY_PERCENT < 100)
+					? percents[i] + RECOVERY_PERCENT : 100;
+		}
+
+		if (percents[i] < 100) {
+			speed[i] = speed[i] * percents[i] / 100;
+		}
+	}
+}
+
+int8_t tractionGetPercent(void) {
+	int8_t lowest = 100, i;
+
+	for (i = 0; i < 4; ++i) {
+		if (percents[i] < lowest) {
+			lowest = percents[i];
+		}
+	}
+
+	return lowest;
+}
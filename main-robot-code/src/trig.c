@@ -0,0 +1,58 @@
+#include "trig.h"
+
+// Sine of 0 to 90 degrees; the other quadrants are found by symmetry
+static const int16_t sineTable[91] = {
+	0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+	2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+	5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+	8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+	10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+	12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+	14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+	15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+	16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+	16384
+};
+
+int16_t trigSin(int16_t degrees) {
+	if (degrees < 90) {
+		return sineTable[degrees];
+	} else if (degrees < 180) {
+		return sineTable[180 - degrees];
+	} else if (degrees < 270) {
+		return -sineTable[degrees - 180];
+	} else {
+		return -sineTable[360 - degrees];
+	}
+}
+
+int16_t trigCos(int16_t degrees) {
+	degrees += 90;
+	return trigSin(degrees < 360 ? degrees : degrees - 360);
+}
+
+int16_t trigAtan2(int32_t y, int32_t x) {
+	int64_t ax = (x < 0) ? -(int64_t) x : x, ay = (y < 0) ? -(int64_t) y : y;
+	int64_t small = (ax < ay) ? ax : ay, large = (ax < ay) ? ay : ax;
+	int16_t low = 0, high = 45, mid, angle;
+
+	// Binary search for the smallest angle up to 45 degrees whose tangent is at least small/large
+	while (low < high) {
+		mid = (low + high) / 2;
+		if (large * sineTable[mid] >= small * sineTable[90 - mid]) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	angle = (ay > ax) ? 90 - low : low;
+	if (x < 0) {
+		angle = 180 - angle;
+	}
+	if (y < 0 && angle != 0) {
+		angle = 360 - angle;
+	}
+
+	return angle;
+}
@@ -0,0 +1,108 @@
+#include "watchdog.h"
+
+#include "main.h"
+#include "memdiag.h"
+
+#define WATCHDOG_PERIOD 20	// ms
+#define RAMP_STEP 8	// speed removed or restored per period, so full speed stops in 320 ms
+
+struct Heartbeat {
+	unsigned long deadline;	// ms allowed between heartbeats
+	volatile unsigned long lastFeed;
+	volatile bool isArmed;
+	bool isLate;
+	uint16_t overruns;
+};
+
+static struct Heartbeat heartbeats[NUM_WATCHDOG_TASKS] = {
+	[WATCHDOG_CONTROL] = { 100 },	// five operator control cycles
+	[WATCHDOG_SENSORS] = { 50 }	// five sensor cycles
+};
+
+static volatile bool isDegraded = false;
+static volatile int16_t speedLimit = MAX_SPEED;
+
+static void rampDown(unsigned char channel) {
+	int speed = motorGet(channel);
+
+	if (speed > RAMP_STEP) {
+		speed -= RAMP_STEP;
+	} else if (speed < -RAMP_STEP) {
+		speed += RAMP_STEP;
+	} else {
+		speed = 0;
+	}
+
+	motorSet(channel, speed);
+}
+
+#define RAMP_DOWN_UNLESS_SHOOTER(name, channel, isInverted, trim, mechanism) \
+	if (mechanism != MECHANISM_SHOOTER) { \
+		rampDown(channel); \
+	}
+
+static void watchdogTask(void *ignore) {
+	unsigned long wakeTime = millis(), lastFeed;
+	struct Heartbeat *heartbeat;
+	bool isArmed, isAnyLate;
+	int8_t i;
+
+	while (true) {
+		isAnyLate = false;
+
+		for (i = 0; i < NUM_WATCHDOG_TASKS; ++i) {
+			heartbeat = &heartbeats[i];
+
+			if (!isEnabled()) {
+				heartbeat->isArmed = false;
+			}
+
+			// Read in the opposite order to watchdogFeed() so a feed in between is never half seen
+			isArmed = heartbeat->isArmed;
+			lastFeed = heartbeat->lastFeed;
+			if (isArmed && millis() - lastFeed > heartbeat->deadline) {
+				// Only counted here; printing could block this task behind the debug UART
+				if (!heartbeat->isLate) {
+					heartbeat->isLate = true;
+					++heartbeat->overruns;
+				}
+				isAnyLate = true;
+			} else {
+				heartbeat->isLate = false;
+			}
+		}
+
+		// The limit follows the ramp down, so the motors come back up from wherever it left them
+		isDegraded = isAnyLate;
+		if (isDegraded) {
+			MOTOR_TABLE(RAMP_DOWN_UNLESS_SHOOTER)
+			speedLimit = (speedLimit > RAMP_STEP) ? speedLimit - RAMP_STEP : 0;
+		} else if (speedLimit < MAX_SPEED) {
+			speedLimit = (speedLimit < MAX_SPEED - RAMP_STEP) ? speedLimit + RAMP_STEP : MAX_SPEED;
+		}
+
+		taskDelayUntil(&wakeTime, WATCHDOG_PERIOD);
+	}
+}
+
+void watchdogInit(void) {
+	memdiagTaskCreate("watchdog", watchdogTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_HIGHEST - 1);
+}
+
+void watchdogFeed(enum WatchdogTask task) {
+	heartbeats[task].lastFeed = millis();
+	heartbeats[task].isArmed = true;
+}
+
+bool watchdogIsDegraded(void) {
+	return isDegraded;
+}
+
+int16_t watchdogGetSpeedLimit(void) {
+	return speedLimit;
+}
+
+uint16_t watchdogGetOverruns(enum WatchdogTask task) {
+	return heartbeats[task].overruns;
+}
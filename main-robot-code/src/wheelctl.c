@@ -0,0 +1,105 @@
+#include "wheelctl.h"
+
+#include "main.h"
+#include "memdiag.h"
+#include "watchdog.h"
+
+// Motor model: velocity rises linearly with command above the command friction takes
+#define MAX_VELOCITY 3920	// IME units at full command; 160 rpm, the free speed of a high speed 393
+#define STATIC_COMMAND 10	// command that just overcomes friction
+
+// PI gains in command per IME unit of error, scaled by 2^GAIN_SHIFT
+#define GAIN_SHIFT 16
+#define KP 655	// 0.01; 25% of full speed slow gives 8 extra command
+#define KI 33	// per cycle
+#define MAX_CORRECTION 30
+
+static const unsigned char channels[4] = { FRONT_LEFT_MOTOR_CHANNEL, BACK_LEFT_MOTOR_CHANNEL,
+		FRONT_RIGHT_MOTOR_CHANNEL, BACK_RIGHT_MOTOR_CHANNEL };
+
+static volatile int16_t targets[4] = { 0 };	// commands
+static int32_t integrals[4] = { 0 };	// scaled by 2^GAIN_SHIFT
+
+static int32_t clamp(int32_t value, int32_t limit) {
+	return (value > limit) ? limit : ((value < -limit) ? -limit : value);
+}
+
+static int16_t getFeedforward(int16_t command) {
+	if (command == 0) {
+		return 0;
+	}
+
+	return (command > 0 ? STATIC_COMMAND : -STATIC_COMMAND)
+			+ command * (MAX_SPEED - STATIC_COMMAND) / MAX_SPEED;
+}
+
+static void wheelctlTask(void *ignore) {
+	unsigned long wakeTime = millis();
+	struct RobotState state;
+
+	while (true) {
+		if (!isEnabled() || watchdogIsDegraded()) {
+			wheelctlReset();
+		} else {
+			robotstateGet(&state);
+			wheelctlUpdate(&state);
+		}
+
+		taskDelayUntil(&wakeTime, WHEELCTL_PERIOD);
+	}
+}
+
+void wheelctlInit(void) {
+	memdiagTaskCreate("wheelctl", wheelctlTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_DEFAULT + 1);
+}
+
+void wheelctlSetTargets(const int16_t commands[4]) {
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		targets[i] = commands[i];
+		LATENCY_COMMAND(MECHANISM_DRIVE, i, commands[i]);
+	}
+}
+
+void wheelctlUpdate(const struct RobotState *state) {
+	int32_t target, error, correction, outputs[4], maxOutput = MAX_SPEED;
+	int16_t command;
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		command = targets[i];
+		target = (int32_t) command * MAX_VELOCITY / MAX_SPEED;
+		error = target - state->wheelVelocities[i];
+
+		// A stopped wheel is left alone rather than held against drift
+		if (command == 0) {
+			integrals[i] = 0;
+			correction = 0;
+		} else {
+			integrals[i] = clamp(integrals[i] + error * KI,
+					(int32_t) MAX_CORRECTION << GAIN_SHIFT);
+			correction = clamp((error * KP + integrals[i]) >> GAIN_SHIFT, MAX_CORRECTION);
+		}
+
+		outputs[i] = getFeedforward(command) + correction;
+		if (abs(outputs[i]) > maxOutput) {
+			maxOutput = abs(outputs[i]);
+		}
+	}
+
+	// Scaled together rather than clipped, so a saturated wheel doesn't bend the robot's path
+	for (i = 0; i < 4; ++i) {
+		mechanismsSetMotorRaw(channels[i], outputs[i] * MAX_SPEED / maxOutput);
+	}
+}
+
+void wheelctlReset(void) {
+	int8_t i;
+
+	for (i = 0; i < 4; ++i) {
+		targets[i] = 0;
+		integrals[i] = 0;
+	}
+}
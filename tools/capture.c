@@ -0,0 +1,119 @@
+#include "capture.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crc.h"
+
+#define MAX_FRAME_LENGTH 256
+
+// Returns the decoded length, or -1 if the frame is malformed
+static int decode(const uint8_t *in, int length, uint8_t *out) {
+	int i = 0, n = 0, j;
+	uint8_t code;
+
+	while (i < length) {
+		code = in[i++];
+		if (code == 0 || i + code - 1 > length) {
+			return -1;
+		}
+
+		for (j = 1; j < code; ++j) {
+			out[n++] = in[i++];
+		}
+
+		if (code < 0xFF && i < length) {
+			out[n++] = 0;
+		}
+	}
+
+	return n;
+}
+
+// The same encoding as the robot's telemetry.c, including the terminating zero
+static int encode(const uint8_t *in, int length, uint8_t *out) {
+	uint8_t *start = out, *code = out++;
+	uint8_t n = 1;
+	int i;
+
+	for (i = 0; i < length; ++i) {
+		if (in[i] == 0) {
+			*code = n;
+			code = out++;
+			n = 1;
+		} else {
+			*out++ = in[i];
+			if (++n == 0xFF) {
+				*code = n;
+				code = out++;
+				n = 1;
+			}
+		}
+	}
+
+	*code = n;
+	*out++ = 0;
+
+	return out - start;
+}
+
+// Returns true if the frame held a tick, which is copied out
+static bool readFrame(struct CaptureReader *reader, const uint8_t *frame, int length,
+		struct TelemetryTick *tick) {
+	uint8_t record[MAX_FRAME_LENGTH];
+	const struct TelemetryHeader *header = (const struct TelemetryHeader *) record;
+	int n = decode(frame, length, record);
+
+	if (n < (int) sizeof(struct TelemetryHeader) + 2
+			|| crc16(record, n - 2) != (record[n - 2] | record[n - 1] << 8)) {
+		++reader->badFrames;
+		return false;
+	}
+
+	n -= 2;
+
+	if (header->version != TELEMETRY_SCHEMA_VERSION || header->type != TELEMETRY_TICK
+			|| n != sizeof(struct TelemetryTick)) {
+		++reader->unknownRecords;
+		return false;
+	}
+
+	memcpy(tick, record, sizeof(struct TelemetryTick));
+	return true;
+}
+
+bool captureReadTick(struct CaptureReader *reader, struct TelemetryTick *tick) {
+	uint8_t frame[MAX_FRAME_LENGTH];
+	int c, length = 0;
+
+	// A frame that overflows the buffer is corrupt; drop it and resynchronize on the next zero
+	while ((c = getc(reader->in)) != EOF) {
+		if (c != 0) {
+			if (length++ < MAX_FRAME_LENGTH) {
+				frame[length - 1] = c;
+			}
+		} else if (length > MAX_FRAME_LENGTH) {
+			++reader->badFrames;
+			length = 0;
+		} else if (length > 0) {
+			if (readFrame(reader, frame, length, tick)) {
+				return true;
+			}
+			length = 0;
+		}
+	}
+
+	return false;
+}
+
+void captureWrite(FILE *out, const void *record, int length) {
+	uint8_t raw[MAX_FRAME_LENGTH];
+	uint8_t frame[MAX_FRAME_LENGTH + MAX_FRAME_LENGTH / 0xFE + 2];
+	uint16_t crc = crc16(record, length);
+
+	memcpy(raw, record, length);
+	raw[length] = crc & 0xFF;
+	raw[length + 1] = crc >> 8;
+
+	fwrite(frame, 1, encode(raw, length + 2, frame), out);
+}
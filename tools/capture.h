@@ -0,0 +1,41 @@
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "telemetryrec.h"
+
+/*
+ * Reads and writes telemetry captures in the format the robot sends them (see telemetryrec.h).
+ * Records are used in place, so this only works on a little-endian host.
+ */
+
+struct CaptureReader {
+	FILE *in;
+	unsigned long badFrames;	// frames that failed their checksum or were cut off
+	unsigned long unknownRecords;	// records of another type or schema version
+};
+
+/**
+ * Reads up to the next tick record, skipping and counting the frames that hold anything else.
+ *
+ * Parameters:
+ * reader - the capture to read; in must be open and the counts zeroed
+ * tick - where to put the record
+ *
+ * Returns: false at the end of the capture
+ */
+bool captureReadTick(struct CaptureReader *reader, struct TelemetryTick *tick);
+
+/**
+ * Writes a record as one frame, with its checksum, exactly as telemetrySend() would.
+ *
+ * Parameters:
+ * out - the capture to write
+ * record - the record, starting with its header
+ * length - the record's size in bytes
+ */
+void captureWrite(FILE *out, const void *record, int length);
+
+#endif /* CAPTURE_H_ */
@@ -0,0 +1,113 @@
+/*
+ * Summarizes the static RAM used by each object file from a GNU linker map, so the modules with
+ * the largest buffers stand out.
+ *
+ * Usage: mapram [map file]
+ *
+ * Reads bin/output.map from the robot code by default. Prints one line per object file with its
+ * initialized (.data) and zeroed (.bss and common) bytes, largest first, followed by the totals.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_MAP "../main-robot-code/bin/output.map"
+#define LINE_LENGTH 512
+#define MODULE_LIMIT 256
+
+struct Module {
+	char name[LINE_LENGTH];
+	unsigned long data, bss;
+};
+
+static struct Module modules[MODULE_LIMIT];
+static int numModules = 0;
+
+static struct Module *findModule(const char *name) {
+	int i;
+
+	for (i = 0; i < numModules; ++i) {
+		if (strcmp(modules[i].name, name) == 0) {
+			return &modules[i];
+		}
+	}
+
+	if (numModules == MODULE_LIMIT) {
+		return NULL;
+	}
+
+	strcpy(modules[numModules].name, name);
+	return &modules[numModules++];
+}
+
+static int compareTotal(const void *a, const void *b) {
+	const struct Module *ma = a, *mb = b;
+	unsigned long ta = ma->data + ma->bss, tb = mb->data + mb->bss;
+	return (ta < tb) - (ta > tb);
+}
+
+// Input sections are indented by one space; long section names push the rest onto the next line
+static int isRamSection(const char *line, int *isData) {
+	char name[LINE_LENGTH];
+
+	if (line[0] != ' ' || sscanf(line, "%s", name) != 1) {
+		return 0;
+	}
+
+	*isData = strncmp(name, ".data", 5) == 0;
+	return *isData || strncmp(name, ".bss", 4) == 0 || strcmp(name, "COMMON") == 0;
+}
+
+int main(int argc, char **argv) {
+	const char *path = argc > 1 ? argv[1] : DEFAULT_MAP;
+	char line[LINE_LENGTH], next[LINE_LENGTH], name[LINE_LENGTH], object[LINE_LENGTH];
+	unsigned long address, size, totalData = 0, totalBss = 0;
+	struct Module *module;
+	int isData, i;
+	FILE *file = fopen(path, "r");
+
+	if (file == NULL) {
+		perror(path);
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (!isRamSection(line, &isData)) {
+			continue;
+		}
+
+		if (sscanf(line, "%s %lx %lx %s", name, &address, &size, object) != 4) {
+			if (fgets(next, sizeof(next), file) == NULL
+					|| sscanf(next, "%lx %lx %s", &address, &size, object) != 3) {
+				continue;
+			}
+		}
+
+		// Sections discarded by --gc-sections are listed at address 0
+		if (size == 0 || address == 0 || (module = findModule(object)) == NULL) {
+			continue;
+		}
+
+		if (isData) {
+			module->data += size;
+			totalData += size;
+		} else {
+			module->bss += size;
+			totalBss += size;
+		}
+	}
+
+	fclose(file);
+
+	qsort(modules, numModules, sizeof(struct Module), compareTotal);
+
+	printf("%8s %8s %8s  %s\n", "data", "bss", "total", "object");
+	for (i = 0; i < numModules; ++i) {
+		printf("%8lu %8lu %8lu  %s\n", modules[i].data, modules[i].bss,
+				modules[i].data + modules[i].bss, modules[i].name);
+	}
+	printf("%8lu %8lu %8lu  total\n", totalData, totalBss, totalData + totalBss);
+
+	return 0;
+}
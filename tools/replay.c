@@ -0,0 +1,135 @@
+/*
+ * Replays a telemetry capture through the robot's operator control code and compares the motor
+ * commands it gives with the ones recorded. A difference means the control code no longer
+ * responds to those inputs the way it did when the capture was made.
+ *
+ * Usage: replay [options] [capture file]
+ *   -q            only print the summary
+ *   -w            write the capture to standard output with its motor commands replaced by the
+ *                 replayed ones
+ *
+ * The capture is read as the robot sent it, so a file saved from the UART can be replayed as is.
+ * Each tick's joysticks and sensor readings are fed to the control code, one opcontrolStep() is
+ * run, and motorGet() is compared with the recorded motors. The drive wheel controllers are
+ * stepped once per WHEELCTL_PERIOD in between, as their task would be. The default
+ * configuration is used, so a capture made with tuned settings will differ wherever they matter.
+ *
+ * golden/ holds scripted captures that cover each control; `make check` replays all of them.
+ * Their motor commands were written by `replay -w`, so they are snapshots of what the control
+ * code did at the time, not independent expectations: a mismatch says the behavior changed, not
+ * that it is wrong. After an intended change, regenerate a capture with
+ * `replay -w golden/x.bin > new.bin` and review the difference with teledecode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "opcontrol.h"
+#include "wheelctl.h"
+#include "capture.h"
+#include "simapi.h"
+
+static void setInputs(const struct TelemetryTick *tick) {
+	struct RobotState sensors = { 0 };
+	int i;
+
+	for (i = 0; i < TELEMETRY_NUM_JOYSTICKS; ++i) {
+		simSetJoystick(i + 1, (tick->connected & (1 << i)) != 0, tick->joysticks[i].axes,
+				tick->joysticks[i].buttons);
+	}
+
+	// Recorded in 1/16 of a degree, the robot's own heading units
+	sensors.heading = tick->heading;
+	sensors.headingWrapped = (int16_t) (sensors.heading / 16 % 360);
+	if (sensors.headingWrapped < 0) {
+		sensors.headingWrapped += 360;
+	}
+
+	sensors.distance = tick->distance;
+	sensors.turnRate = tick->turnRate;
+	sensors.shooterVelocity = tick->shooterVelocity;
+	for (i = 0; i < TELEMETRY_NUM_WHEELS; ++i) {
+		sensors.wheelVelocities[i] = tick->wheelVelocities[i];
+	}
+
+	simSetSensors(&sensors);
+}
+
+static void usage(void) {
+	fprintf(stderr, "usage: replay [-q] [-w] [capture file]\n");
+	exit(1);
+}
+
+int main(int argc, char **argv) {
+	struct CaptureReader reader = { stdin, 0, 0 };
+	struct TelemetryTick tick;
+	bool isQuiet = false, isRewriting = false, isFirst = true, isMismatched;
+	int opt, i, replayed;
+	unsigned long lastTime = 0, ticks = 0, mismatchedTicks = 0;
+
+	while ((opt = getopt(argc, argv, "qw")) != -1) {
+		switch (opt) {
+		case 'q': isQuiet = true; break;
+		case 'w': isRewriting = true; break;
+		default: usage();
+		}
+	}
+
+	if (optind < argc && (reader.in = fopen(argv[optind], "rb")) == NULL) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	simInitControls();
+
+	while (captureReadTick(&reader, &tick)) {
+		// The wheel controllers ran on the previous tick's targets until this cycle
+		if (isFirst) {
+			lastTime = tick.time;
+			isFirst = false;
+		}
+		for (; lastTime + WHEELCTL_PERIOD <= tick.time; lastTime += WHEELCTL_PERIOD) {
+			simStepWheels();
+		}
+
+		simSetTime(tick.time);
+		setInputs(&tick);
+		opcontrolStep();
+
+		isMismatched = false;
+		for (i = 0; i < TELEMETRY_NUM_MOTORS; ++i) {
+			replayed = simGetMotor(i + 1);
+
+			if (isRewriting) {
+				tick.motors[i] = (int8_t) replayed;
+			} else if (replayed != tick.motors[i]) {
+				isMismatched = true;
+				if (!isQuiet) {
+					printf("time_ms=%lu motor=%d recorded=%d replayed=%d\n",
+							(unsigned long) tick.time, i + 1, tick.motors[i], replayed);
+				}
+			}
+		}
+
+		if (isRewriting) {
+			captureWrite(stdout, &tick, sizeof(tick));
+		}
+
+		++ticks;
+		if (isMismatched) {
+			++mismatchedTicks;
+		}
+	}
+
+	if (reader.badFrames > 0 || reader.unknownRecords > 0) {
+		fprintf(stderr, "replay: skipped %lu bad frames, %lu unknown records\n",
+				reader.badFrames, reader.unknownRecords);
+	}
+
+	if (!isRewriting) {
+		printf("ticks=%lu mismatched_ticks=%lu\n", ticks, mismatchedTicks);
+	}
+
+	return mismatchedTicks > 0 ? 1 : 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * Deterministic physics model of the X-drive chassis and the dual-motor flywheel, driven by the
+ * robot's own drive() and shooter() code. Runs far faster than real time so filter lengths and
+ * presets can be swept offline.
+ *
+ * Usage: sim [options]
+ *   -s scenario   strafe, diagonal, spin, shooter or field (default strafe)
+ *   -d cycles     drive filter length (default 12)
+ *   -f cycles     shooter filter length (default 12)
+ *   -p speed      shooter command for the shooter scenario (default 75)
+ *   -t seconds    length of the scenario (default 4)
+ *   -V velocity   shooter IME velocity at full command; closes the shooter loop (default 0)
+ *   -K gain       shooter proportional gain (default 0)
+ *   -I gain       shooter integral gain per control cycle (default 0)
+ *   -c            print a CSV trace of every control cycle instead of a summary
+ *
+ * The field scenario starts the robot turned 90 degrees counterclockwise and drives it forward
+ * field-centric, so it should travel along +y with x staying near 0.
+ *
+ * The summary is a single line of key=value pairs so that sweeps can be collected with a shell
+ * loop and compared with any text tool.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "actions.h"
+#include "simapi.h"
+
+#define PHYSICS_STEP 0.001	// s
+#define CONTROL_PERIOD 20	// ms, the same as operatorControl()
+
+// 393 motors in high speed configuration at 7.2 V
+#define MOTOR_STALL_TORQUE 1.04	// N m
+#define MOTOR_FREE_SPEED 16.76	// rad/s
+
+// Chassis
+#define ROBOT_MASS 6.0	// kg
+#define ROBOT_INERTIA 0.25	// kg m^2
+#define WHEEL_RADIUS 0.0508	// m, 4 in omni wheels
+#define WHEEL_OFFSET 0.17	// m from the center along each axis
+#define ROLLING_FRICTION 3.0	// N
+#define TURNING_FRICTION 0.4	// N m
+
+// Flywheel, two motors geared up 1:15
+#define FLYWHEEL_RATIO 15.0
+#define FLYWHEEL_INERTIA 0.0015	// kg m^2
+#define FLYWHEEL_RADIUS 0.063	// m
+#define FLYWHEEL_FRICTION 0.02	// N m
+#define BALL_MASS 0.06	// kg
+#define BALL_FEED_PERIOD 500	// ms between balls while the lifter runs
+
+#define SQRT_HALF 0.70710678
+
+struct Chassis {
+	double vx, vy, w;	// robot frame, m/s and rad/s counterclockwise
+	double x, y, theta;	// field frame, m and rad
+};
+
+// Directions each wheel pushes the robot on a positive command, matching the mixing in drive()
+static const double wheelDir[SIM_NUM_WHEELS][2] = {
+	{ SQRT_HALF, SQRT_HALF },	// front left
+	{ -SQRT_HALF, SQRT_HALF },	// back left
+	{ SQRT_HALF, -SQRT_HALF },	// front right
+	{ -SQRT_HALF, -SQRT_HALF }	// back right
+};
+
+static const double wheelPos[SIM_NUM_WHEELS][2] = {
+	{ -WHEEL_OFFSET, WHEEL_OFFSET },
+	{ -WHEEL_OFFSET, -WHEEL_OFFSET },
+	{ WHEEL_OFFSET, WHEEL_OFFSET },
+	{ WHEEL_OFFSET, -WHEEL_OFFSET }
+};
+
+static double motorTorque(double command, double speed) {
+	double torque = MOTOR_STALL_TORQUE * (command / 127.0 - speed / MOTOR_FREE_SPEED);
+	return fmax(-MOTOR_STALL_TORQUE, fmin(MOTOR_STALL_TORQUE, torque));
+}
+
+static double coulomb(double friction, double speed, double force) {
+	if (fabs(speed) > 1e-4) {
+		return speed > 0 ? -friction : friction;
+	}
+	return fabs(force) < friction ? -force : (force > 0 ? -friction : friction);
+}
+
+// Wheel speed along its driving direction in rad/s, including the rotation of the robot
+static double wheelSpeed(const struct Chassis *c, int i) {
+	return (wheelDir[i][0] * (c->vx - c->w * wheelPos[i][1])
+			+ wheelDir[i][1] * (c->vy + c->w * wheelPos[i][0])) / WHEEL_RADIUS;
+}
+
+static void stepChassis(struct Chassis *c, const int8_t commands[SIM_NUM_WHEELS]) {
+	double fx = 0, fy = 0, t = 0, force, speed, c0, s0;
+	int i;
+
+	for (i = 0; i < SIM_NUM_WHEELS; ++i) {
+		speed = wheelSpeed(c, i);
+		force = motorTorque(commands[i], speed) / WHEEL_RADIUS;
+
+		fx += force * wheelDir[i][0];
+		fy += force * wheelDir[i][1];
+		t += wheelPos[i][0] * force * wheelDir[i][1] - wheelPos[i][1] * force * wheelDir[i][0];
+	}
+
+	fx += coulomb(ROLLING_FRICTION, c->vx, fx);
+	fy += coulomb(ROLLING_FRICTION, c->vy, fy);
+	t += coulomb(TURNING_FRICTION, c->w, t);
+
+	// The robot frame rotates with the chassis, which turns its velocity the other way
+	c->vx += (fx / ROBOT_MASS + c->w * c->vy) * PHYSICS_STEP;
+	c->vy += (fy / ROBOT_MASS - c->w * c->vx) * PHYSICS_STEP;
+	c->w += t / ROBOT_INERTIA * PHYSICS_STEP;
+
+	c0 = cos(c->theta);
+	s0 = sin(c->theta);
+	c->x += (c->vx * c0 - c->vy * s0) * PHYSICS_STEP;
+	c->y += (c->vx * s0 + c->vy * c0) * PHYSICS_STEP;
+	c->theta += c->w * PHYSICS_STEP;
+}
+
+static void stepFlywheel(double *w, int8_t command) {
+	double motorSpeed = *w / FLYWHEEL_RATIO;
+	double torque = 2 * motorTorque(command, motorSpeed) / FLYWHEEL_RATIO;
+
+	torque += coulomb(FLYWHEEL_FRICTION, *w, torque);
+	*w += torque / FLYWHEEL_INERTIA * PHYSICS_STEP;
+}
+
+// The ball leaves at about half the rim speed, taking its energy from the flywheel
+static void launchBall(double *w) {
+	*w *= FLYWHEEL_INERTIA / (FLYWHEEL_INERTIA
+			+ 0.5 * BALL_MASS * FLYWHEEL_RADIUS * FLYWHEEL_RADIUS);
+}
+
+static void getInputs(const char *scenario, unsigned long ms, int8_t *vx, int8_t *vy, int8_t *r,
+		int8_t *lifterSpeed) {
+	bool isActive = ms < 3000;
+
+	*vx = *vy = *r = *lifterSpeed = 0;
+
+	if (strcmp(scenario, "strafe") == 0) {
+		*vx = isActive ? 127 : 0;
+	} else if (strcmp(scenario, "diagonal") == 0) {
+		*vx = isActive ? 127 : 0;
+		*vy = isActive ? 64 : 0;
+	} else if (strcmp(scenario, "spin") == 0) {
+		*r = isActive ? 63 : 0;
+	} else if (strcmp(scenario, "shooter") == 0) {
+		*lifterSpeed = ms >= 2000 ? 60 : 0;
+	} else if (strcmp(scenario, "field") == 0) {
+		*vy = isActive ? 127 : 0;
+	}
+}
+
+static double peak(const double *trace, unsigned long ticks) {
+	double max = 0;
+	unsigned long i;
+
+	for (i = 0; i < ticks; ++i) {
+		max = fmax(max, trace[i]);
+	}
+
+	return max;
+}
+
+// Time for a trace to first reach 90% of its peak, or -1 if it never moved
+static long riseTime(const double *trace, unsigned long ticks) {
+	double target = 0.9 * peak(trace, ticks);
+	unsigned long i;
+
+	for (i = 0; i < ticks && target > 0; ++i) {
+		if (trace[i] >= target) {
+			return (long) (i * CONTROL_PERIOD);
+		}
+	}
+
+	return -1;
+}
+
+static void usage(void) {
+	fprintf(stderr, "usage: sim [-s strafe|diagonal|spin|shooter|field] [-d cycles] [-f cycles] "
+			"[-p speed] [-t seconds] [-V velocity] [-K gain] [-I gain] [-c]\n");
+	exit(1);
+}
+
+int main(int argc, char **argv) {
+	const char *scenario = "strafe";
+	int driveCycles = 12, shooterCycles = 12, shooterSpeed = 75, opt;
+	double duration = 4, kp = 0, ki = 0;
+	int maxVelocity = 0;
+	bool isCsv = false;
+
+	struct Chassis chassis = { 0 };
+	double flywheel = 0, lowestAfterBall = 1e9;
+	double *speeds, *flywheelSpeeds, wheelSpeeds[SIM_NUM_WHEELS];
+	bool isFieldCentric;
+	unsigned long ms, steps, i, ticks, lastBall = 0, balls = 0;
+	int8_t vx, vy, r, lifterSpeed, commands[SIM_NUM_WHEELS];
+
+	while ((opt = getopt(argc, argv, "s:d:f:p:t:V:K:I:c")) != -1) {
+		switch (opt) {
+		case 's': scenario = optarg; break;
+		case 'd': driveCycles = atoi(optarg); break;
+		case 'f': shooterCycles = atoi(optarg); break;
+		case 'p': shooterSpeed = atoi(optarg); break;
+		case 't': duration = atof(optarg); break;
+		case 'V': maxVelocity = atoi(optarg); break;
+		case 'K': kp = atof(optarg); break;
+		case 'I': ki = atof(optarg); break;
+		case 'c': isCsv = true; break;
+		default: usage();
+		}
+	}
+
+	simInitFilters(driveCycles, shooterCycles, 7, 8);
+	simSetShooterGains(maxVelocity, kp, ki);
+
+	isFieldCentric = strcmp(scenario, "field") == 0;
+	if (isFieldCentric) {
+		chassis.theta = M_PI / 2;
+	}
+
+	if (isCsv) {
+		printf("time_ms,x_m,y_m,heading_deg,vx_mps,vy_mps,flywheel_rpm,fl,bl,fr,br\n");
+	}
+
+	steps = CONTROL_PERIOD / (PHYSICS_STEP * 1000);
+	ticks = duration * 1000 / CONTROL_PERIOD;
+	speeds = calloc(ticks, sizeof(double));
+	flywheelSpeeds = calloc(ticks, sizeof(double));
+
+	for (ms = 0; ms < ticks * CONTROL_PERIOD; ms += CONTROL_PERIOD) {
+		simSetTime(ms);
+		simSetHeading(chassis.theta * 180 / M_PI, chassis.w * 180 / M_PI);
+		simSetDistance(100);
+		simSetShooterSpeed(flywheel / FLYWHEEL_RATIO * 60 / (2 * M_PI));
+		simSetChassisVelocity(chassis.vx, chassis.vy);
+		for (i = 0; i < SIM_NUM_WHEELS; ++i) {
+			wheelSpeeds[i] = wheelSpeed(&chassis, i);
+		}
+		simSetWheelSpeeds(wheelSpeeds);
+
+		getInputs(scenario, ms, &vx, &vy, &r, &lifterSpeed);
+		drive(vx, vy, r, isFieldCentric);
+		simStepWheels();
+		shooter(strcmp(scenario, "shooter") == 0 ? shooterSpeed : 0);
+		lifter(lifterSpeed);
+
+		simGetDriveCommands(commands);
+		for (i = 0; i < steps; ++i) {
+			stepChassis(&chassis, commands);
+			stepFlywheel(&flywheel, simGetShooterCommand());
+		}
+
+		if (simGetLifterCommand() > 0 && ms - lastBall >= BALL_FEED_PERIOD) {
+			launchBall(&flywheel);
+			lastBall = ms;
+			++balls;
+		}
+
+		speeds[ms / CONTROL_PERIOD] = hypot(chassis.vx, chassis.vy);
+		flywheelSpeeds[ms / CONTROL_PERIOD] = flywheel;
+		if (balls > 0 && flywheel < lowestAfterBall) {
+			lowestAfterBall = flywheel;
+		}
+
+		if (isCsv) {
+			printf("%lu,%.4f,%.4f,%.2f,%.4f,%.4f,%.1f,%d,%d,%d,%d\n", ms, chassis.x, chassis.y,
+					chassis.theta * 180 / M_PI, chassis.vx, chassis.vy,
+					flywheel * 60 / (2 * M_PI), commands[0], commands[1], commands[2],
+					commands[3]);
+		}
+	}
+
+	if (!isCsv) {
+		printf("scenario=%s drive_cycles=%d shooter_cycles=%d peak_speed_mps=%.3f "
+				"speed_rise_ms=%ld x_m=%.3f y_m=%.3f heading_deg=%.2f flywheel_rpm=%.1f "
+				"flywheel_rise_ms=%ld balls=%lu min_rpm_after_ball=%.1f\n",
+				scenario, driveCycles, shooterCycles, peak(speeds, ticks),
+				riseTime(speeds, ticks), chassis.x, chassis.y, chassis.theta * 180 / M_PI,
+				peak(flywheelSpeeds, ticks) * 60 / (2 * M_PI), riseTime(flywheelSpeeds, ticks),
+				balls, balls > 0 ? lowestAfterBall * 60 / (2 * M_PI) : 0.0);
+	}
+
+	free(speeds);
+	free(flywheelSpeeds);
+	return 0;
+}
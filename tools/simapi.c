@@ -0,0 +1,243 @@
+/*
+ * Stand-ins for the parts of the PROS API used by the control code under simulation.
+ */
+
+#include "main.h"
+#include "config.h"
+#include "heading.h"
+#include "robotstate.h"
+#include "wheelctl.h"
+#include "memdiag.h"
+#include "watchdog.h"
+#include "opcontrol.h"
+#include "profiler.h"
+#include "simapi.h"
+#include <math.h>
+
+#define NUM_JOYSTICKS 2
+
+struct Joystick {
+	bool isConnected;
+	int8_t axes[4];
+	uint16_t buttons;
+};
+
+static int motors[10];
+static unsigned long now;
+static struct RobotState state;	// stands in for the sensor task's snapshot
+static struct Joystick joysticks[NUM_JOYSTICKS];
+
+void simInitFilters(int8_t driveCycles, int8_t shooterCycles, int8_t intakeCycles,
+		int8_t lifterCycles) {
+	configLoadDefaults();
+
+	config.driveNumFilterCycles = driveCycles;
+	config.intakeNumFilterCycles = intakeCycles;
+	config.lifterNumFilterCycles = lifterCycles;
+	config.shooterNumFilterCycles = shooterCycles;
+
+	mechanismsInit();
+}
+
+void simInitControls(void) {
+	configLoadDefaults();
+	mechanismsInit();
+	opcontrolInit();
+	opcontrolReset();
+}
+
+void simSetShooterGains(int16_t maxVelocity, double kp, double ki) {
+	config.shooterMaxVelocity = maxVelocity;
+	config.shooterKp = (int32_t) (kp * CONFIG_GAIN_ONE);
+	config.shooterKi = (int32_t) (ki * CONFIG_GAIN_ONE);
+}
+
+void simGetDriveCommands(int8_t commands[SIM_NUM_WHEELS]) {
+	commands[SIM_FRONT_LEFT] = motors[FRONT_LEFT_MOTOR_CHANNEL - 1];
+	commands[SIM_BACK_LEFT] = motors[BACK_LEFT_MOTOR_CHANNEL - 1];
+	commands[SIM_FRONT_RIGHT] = motors[FRONT_RIGHT_MOTOR_CHANNEL - 1];
+	commands[SIM_BACK_RIGHT] = motors[BACK_RIGHT_MOTOR_CHANNEL - 1];
+}
+
+// The two flywheel motors face each other, so channel 8 turns forward on negative commands
+int8_t simGetShooterCommand(void) {
+	return (motors[SHOOTER_MOTOR_CHANNEL2 - 1] - motors[SHOOTER_MOTOR_CHANNEL - 1]) / 2;
+}
+
+int8_t simGetLifterCommand(void) {
+	return motors[LIFTER_MOTOR_CHANNEL - 1];
+}
+
+int simGetMotor(unsigned char channel) {
+	return motorGet(channel);
+}
+
+void simSetTime(unsigned long ms) {
+	now = ms;
+	state.time = ms;
+	robotstatePublish(&state);
+}
+
+void simSetHeading(double degrees, double degreesPerSecond) {
+	state.heading = (int32_t) (degrees * HEADING_SCALE);
+	state.headingWrapped = (int16_t) (state.heading / HEADING_SCALE % 360);
+	if (state.headingWrapped < 0) {
+		state.headingWrapped += 360;
+	}
+	state.turnRate = (int16_t) degreesPerSecond;
+	robotstatePublish(&state);
+}
+
+void simSetDistance(double cm) {
+	state.distance = (int16_t) cm;
+	state.range = (int16_t) (cm / 2.54 * ODOMETRY_SCALE);	// the filter settles on the ping
+	robotstatePublish(&state);
+}
+
+// Reported in the units of a 393 IME in high speed mode
+void simSetShooterSpeed(double motorRpm) {
+	state.shooterVelocity = (int16_t) (motorRpm * 24.5);
+	robotstatePublish(&state);
+}
+
+// Wheel rad/s, reported in the units of a 393 IME in high speed mode
+void simSetWheelSpeeds(const double radPerSecond[SIM_NUM_WHEELS]) {
+	int8_t i;
+
+	for (i = 0; i < SIM_NUM_WHEELS; ++i) {
+		state.wheelVelocities[i] = (int16_t) (radPerSecond[i] * 60 / (2 * M_PI) * 24.5);
+	}
+	robotstatePublish(&state);
+}
+
+// Robot frame m/s, reported as the drive IME odometry would
+void simSetChassisVelocity(double vx, double vy) {
+	state.velocityX = (int16_t) (vx * 39.37 * ODOMETRY_SCALE);
+	state.velocityY = (int16_t) (vy * 39.37 * ODOMETRY_SCALE);
+	robotstatePublish(&state);
+}
+
+void simSetSensors(const struct RobotState *sensors) {
+	state = *sensors;
+	state.time = now;
+	robotstatePublish(&state);
+}
+
+void simSetJoystick(unsigned char slot, bool isConnected, const int8_t axes[4], uint16_t buttons) {
+	struct Joystick *joystick;
+	int8_t i;
+
+	if (slot < 1 || slot > NUM_JOYSTICKS) {
+		return;
+	}
+
+	joystick = &joysticks[slot - 1];
+	joystick->isConnected = isConnected;
+	for (i = 0; i < 4; ++i) {
+		joystick->axes[i] = axes[i];
+	}
+	joystick->buttons = buttons;
+}
+
+bool isJoystickConnected(unsigned char joystick) {
+	return joystick >= 1 && joystick <= NUM_JOYSTICKS && joysticks[joystick - 1].isConnected;
+}
+
+int joystickGetAnalog(unsigned char joystick, unsigned char axis) {
+	if (!isJoystickConnected(joystick) || axis < 1 || axis > 4) {
+		return 0;
+	}
+
+	return joysticks[joystick - 1].axes[axis - 1];
+}
+
+// Groups 5 to 8 take 4 bits each, from the lowest, with each button at the bit of its JOY_* mask
+bool joystickGetDigital(unsigned char joystick, unsigned char buttonGroup, unsigned char button) {
+	if (!isJoystickConnected(joystick) || buttonGroup < 5 || buttonGroup > 8) {
+		return false;
+	}
+
+	return (joysticks[joystick - 1].buttons & ((uint16_t) button << ((buttonGroup - 5) * 4))) != 0;
+}
+
+int motorGet(unsigned char channel) {
+	return (channel > 0 && channel <= 10) ? motors[channel - 1] : 0;
+}
+
+void motorSet(unsigned char channel, int speed) {
+	if (channel > 0 && channel <= 10) {
+		motors[channel - 1] = speed > 127 ? 127 : (speed < -127 ? -127 : speed);
+	}
+}
+
+unsigned long millis() {
+	return now;
+}
+
+unsigned long micros() {
+	return now * 1000;
+}
+
+// The simulation runs in a single task, so locks are never contended
+Mutex mutexCreate() {
+	return NULL;
+}
+
+bool mutexTake(Mutex mutex, const unsigned long blockTime) {
+	return true;
+}
+
+bool mutexGive(Mutex mutex) {
+	return true;
+}
+
+// Tuning needs the real flywheel, so it never starts
+void autotuneStart(void) {
+}
+
+bool autotuneIsRunning(void) {
+	return false;
+}
+
+// The wheel controllers are stepped by simStepWheels() instead of their own task
+void simStepWheels(void) {
+	wheelctlUpdate(&state);
+}
+
+TaskHandle memdiagTaskCreate(const char *name, TaskCode taskCode, unsigned int stackDepth,
+		void *parameters, unsigned int priority) {
+	return NULL;
+}
+
+// Only reached from the tasks' loops, which the simulation never runs
+void delay(const unsigned long time) {
+}
+
+void taskDelayUntil(unsigned long *previousWakeTime, const unsigned long cycleTime) {
+	*previousWakeTime += cycleTime;
+}
+
+bool isEnabled() {
+	return true;
+}
+
+#ifdef PROFILER
+
+// Loop timings mean nothing under simulation, so they are thrown away
+unsigned long profilerStarts[NUM_PROFILE_STAGES];
+
+void profilerRecord(enum ProfileStage stage, unsigned long elapsed) {
+}
+
+#endif
+
+void watchdogFeed(enum WatchdogTask task) {
+}
+
+bool watchdogIsDegraded(void) {
+	return false;
+}
+
+int16_t watchdogGetSpeedLimit(void) {
+	return MAX_SPEED;
+}
@@ -0,0 +1,51 @@
+/*
+ * The interface between the physics model and the stand-ins for the PROS API that the robot's
+ * control code calls during a simulation. Kept free of API.h so the model can use the host's
+ * standard library.
+ */
+
+#ifndef SIMAPI_H_
+#define SIMAPI_H_
+
+#include "robotstate.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+enum SimWheel { SIM_FRONT_LEFT, SIM_BACK_LEFT, SIM_FRONT_RIGHT, SIM_BACK_RIGHT, SIM_NUM_WHEELS };
+
+// Loads the default configuration and initializes the control code's filters the same way
+// initialize() does
+void simInitFilters(int8_t driveCycles, int8_t shooterCycles, int8_t intakeCycles,
+		int8_t lifterCycles);
+
+// Loads the default configuration and sets up the mechanisms and operator control the same way
+// initialize() and the start of operatorControl() do
+void simInitControls(void);
+
+// Overrides the shooter's velocity loop settings; a maxVelocity of 0 leaves it open loop
+void simSetShooterGains(int16_t maxVelocity, double kp, double ki);
+
+// Reads the commands last written by the control code
+void simGetDriveCommands(int8_t commands[SIM_NUM_WHEELS]);
+int8_t simGetShooterCommand(void);
+int8_t simGetLifterCommand(void);
+int simGetMotor(unsigned char channel);
+
+// Feeds the model's state back to the control code's sensors
+void simSetTime(unsigned long ms);
+void simSetHeading(double degrees, double degreesPerSecond);
+void simSetDistance(double cm);
+void simSetShooterSpeed(double motorRpm);
+void simSetChassisVelocity(double vx, double vy);
+void simSetWheelSpeeds(const double radPerSecond[SIM_NUM_WHEELS]);
+
+// Replaces every sensor reading at once with raw values, as they were recorded on the robot
+void simSetSensors(const struct RobotState *sensors);
+
+// Sets what a joystick reports; buttons are groups 5 to 8 laid out as in controlsGetSnapshot()
+void simSetJoystick(unsigned char slot, bool isConnected, const int8_t axes[4], uint16_t buttons);
+
+// Runs one cycle of the drive wheels' velocity controllers
+void simStepWheels(void);
+
+#endif /* SIMAPI_H_ */
@@ -0,0 +1,75 @@
+/*
+ * Decodes a telemetry capture from the robot's UART into CSV.
+ *
+ * Usage: teledecode [capture file] > out.csv
+ *
+ * Reads standard input if no file is given. Frames that fail their checksum or were written with
+ * a different schema version are skipped and counted on standard error.
+ */
+
+#include <stdio.h>
+
+#include "capture.h"
+
+static const char *joystickNames[TELEMETRY_NUM_JOYSTICKS] = { "driver", "partner" };
+
+static void printTick(const struct TelemetryTick *tick) {
+	int i, j;
+
+	printf("%lu,%u", (unsigned long) tick->time, tick->loopTime);
+	for (i = 0; i < TELEMETRY_NUM_JOYSTICKS; ++i) {
+		for (j = 0; j < TELEMETRY_NUM_AXES; ++j) {
+			printf(",%d", tick->joysticks[i].axes[j]);
+		}
+		printf(",0x%04x", tick->joysticks[i].buttons);
+	}
+	printf(",0x%x,0x%x", tick->connected, tick->partnerRoles);
+	for (i = 0; i < TELEMETRY_NUM_MOTORS; ++i) {
+		printf(",%d", tick->motors[i]);
+	}
+	printf(",%.4f,%d,%d,%d", tick->heading / 16.0, tick->distance, tick->turnRate,
+			tick->shooterVelocity);
+	for (i = 0; i < TELEMETRY_NUM_WHEELS; ++i) {
+		printf(",%d", tick->wheelVelocities[i]);
+	}
+	printf("\n");
+}
+
+int main(int argc, char **argv) {
+	struct CaptureReader reader = { stdin, 0, 0 };
+	struct TelemetryTick tick;
+	int i, j;
+
+	if (argc > 1 && (reader.in = fopen(argv[1], "rb")) == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+
+	printf("time_ms,loop_us");
+	for (i = 0; i < TELEMETRY_NUM_JOYSTICKS; ++i) {
+		for (j = 1; j <= TELEMETRY_NUM_AXES; ++j) {
+			printf(",%s_axis%d", joystickNames[i], j);
+		}
+		printf(",%s_buttons", joystickNames[i]);
+	}
+	printf(",connected,partner_roles");
+	for (i = 1; i <= TELEMETRY_NUM_MOTORS; ++i) {
+		printf(",motor%d", i);
+	}
+	printf(",heading_deg,distance_cm,turn_rate_dps,shooter_velocity");
+	for (i = 1; i <= TELEMETRY_NUM_WHEELS; ++i) {
+		printf(",wheel%d_velocity", i);
+	}
+	printf("\n");
+
+	while (captureReadTick(&reader, &tick)) {
+		printTick(&tick);
+	}
+
+	if (reader.badFrames > 0 || reader.unknownRecords > 0) {
+		fprintf(stderr, "%lu bad frames, %lu unknown records\n", reader.badFrames,
+				reader.unknownRecords);
+	}
+
+	return 0;
+}